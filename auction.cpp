@@ -0,0 +1,296 @@
+#include "auction.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define HFT_X86_SIMD 1
+#endif
+
+namespace hft {
+
+namespace {
+
+void prefix_sum_scalar(const uint64_t *in, uint64_t *out, size_t n) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < n; ++i) {
+    sum += in[i];
+    out[i] = sum;
+  }
+}
+
+// Per-price demand (bid quantity at or above the price) and executable
+// volume min(demand, supply); returns the largest executable volume
+uint64_t executable_scalar(const uint64_t *bid_prefix,
+                           const uint64_t *bid_quantity,
+                           const uint64_t *ask_prefix, uint64_t total_bid,
+                           uint64_t *demand, uint64_t *volume, size_t n) {
+  uint64_t best = 0;
+  for (size_t i = 0; i < n; ++i) {
+    demand[i] = total_bid - bid_prefix[i] + bid_quantity[i];
+    volume[i] = std::min(demand[i], ask_prefix[i]);
+    best = std::max(best, volume[i]);
+  }
+  return best;
+}
+
+#ifdef HFT_X86_SIMD
+
+// Two lanes: add the lane to its left, then the running carry
+void prefix_sum_sse2(const uint64_t *in, uint64_t *out, size_t n) {
+  __m128i carry = _mm_setzero_si128();
+  size_t i = 0;
+
+  for (; i + 2 <= n; i += 2) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi64(x, carry);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), x);
+    carry = _mm_unpackhi_epi64(x, x);
+  }
+
+  uint64_t sum = i > 0 ? out[i - 1] : 0;
+  for (; i < n; ++i) {
+    sum += in[i];
+    out[i] = sum;
+  }
+}
+
+// Four lanes: shift-and-add by one lane, then by two, then add the carry
+__attribute__((target("avx2"))) void
+prefix_sum_avx2(const uint64_t *in, uint64_t *out, size_t n) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i carry = zero;
+  size_t i = 0;
+
+  for (; i + 4 <= n; i += 4) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    __m256i by_one = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0));
+    by_one = _mm256_blend_epi32(by_one, zero, 0x03);
+    x = _mm256_add_epi64(x, by_one);
+    x = _mm256_add_epi64(x, _mm256_permute2x128_si256(x, x, 0x08));
+    x = _mm256_add_epi64(x, carry);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), x);
+    carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+  }
+
+  uint64_t sum = i > 0 ? out[i - 1] : 0;
+  for (; i < n; ++i) {
+    sum += in[i];
+    out[i] = sum;
+  }
+}
+
+// SSE2 has no 64-bit compare: signed on the high dwords, unsigned on the
+// low dwords, combined per lane
+__m128i cmpgt_epi64_sse2(__m128i a, __m128i b) {
+  const __m128i low_sign = _mm_set_epi32(0, INT32_MIN, 0, INT32_MIN);
+  a = _mm_xor_si128(a, low_sign);
+  b = _mm_xor_si128(b, low_sign);
+
+  __m128i gt = _mm_cmpgt_epi32(a, b);
+  __m128i eq = _mm_cmpeq_epi32(a, b);
+  __m128i gt_low = _mm_shuffle_epi32(gt, _MM_SHUFFLE(2, 2, 0, 0));
+  __m128i gt_high = _mm_shuffle_epi32(gt, _MM_SHUFFLE(3, 3, 1, 1));
+  __m128i eq_high = _mm_shuffle_epi32(eq, _MM_SHUFFLE(3, 3, 1, 1));
+  return _mm_or_si128(gt_high, _mm_and_si128(eq_high, gt_low));
+}
+
+// mask ? a : b
+__m128i select_sse2(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Quantities stay far below 2^63, so signed 64-bit compares are safe
+uint64_t executable_sse2(const uint64_t *bid_prefix,
+                         const uint64_t *bid_quantity,
+                         const uint64_t *ask_prefix, uint64_t total_bid,
+                         uint64_t *demand, uint64_t *volume, size_t n) {
+  const __m128i total = _mm_set1_epi64x(static_cast<int64_t>(total_bid));
+  __m128i best = _mm_setzero_si128();
+  size_t i = 0;
+
+  for (; i + 2 <= n; i += 2) {
+    __m128i bp =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(bid_prefix + i));
+    __m128i bq =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(bid_quantity + i));
+    __m128i ap =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(ask_prefix + i));
+
+    __m128i d = _mm_add_epi64(_mm_sub_epi64(total, bp), bq);
+    __m128i v = select_sse2(cmpgt_epi64_sse2(d, ap), ap, d);
+    best = select_sse2(cmpgt_epi64_sse2(v, best), v, best);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(demand + i), d);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(volume + i), v);
+  }
+
+  alignas(16) uint64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), best);
+  uint64_t result = std::max(lanes[0], lanes[1]);
+
+  return std::max(result,
+                  executable_scalar(bid_prefix + i, bid_quantity + i,
+                                    ask_prefix + i, total_bid, demand + i,
+                                    volume + i, n - i));
+}
+
+__attribute__((target("avx2"))) uint64_t
+executable_avx2(const uint64_t *bid_prefix, const uint64_t *bid_quantity,
+                const uint64_t *ask_prefix, uint64_t total_bid,
+                uint64_t *demand, uint64_t *volume, size_t n) {
+  const __m256i total = _mm256_set1_epi64x(static_cast<int64_t>(total_bid));
+  __m256i best = _mm256_setzero_si256();
+  size_t i = 0;
+
+  for (; i + 4 <= n; i += 4) {
+    __m256i bp =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bid_prefix + i));
+    __m256i bq =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bid_quantity + i));
+    __m256i ap =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ask_prefix + i));
+
+    __m256i d = _mm256_add_epi64(_mm256_sub_epi64(total, bp), bq);
+    __m256i v = _mm256_blendv_epi8(d, ap, _mm256_cmpgt_epi64(d, ap));
+    best = _mm256_blendv_epi8(best, v, _mm256_cmpgt_epi64(v, best));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(demand + i), d);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(volume + i), v);
+  }
+
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), best);
+  uint64_t result = std::max(std::max(lanes[0], lanes[1]),
+                             std::max(lanes[2], lanes[3]));
+
+  return std::max(result,
+                  executable_scalar(bid_prefix + i, bid_quantity + i,
+                                    ask_prefix + i, total_bid, demand + i,
+                                    volume + i, n - i));
+}
+
+#endif // HFT_X86_SIMD
+
+std::atomic<AuctionKernel> &active_kernel() {
+  static std::atomic<AuctionKernel> kernel{detected_auction_kernel()};
+  return kernel;
+}
+
+uint64_t executable(const uint64_t *bid_prefix, const uint64_t *bid_quantity,
+                    const uint64_t *ask_prefix, uint64_t total_bid,
+                    uint64_t *demand, uint64_t *volume, size_t n) {
+  switch (auction_kernel()) {
+#ifdef HFT_X86_SIMD
+  case AuctionKernel::AVX2:
+    return executable_avx2(bid_prefix, bid_quantity, ask_prefix, total_bid,
+                           demand, volume, n);
+  case AuctionKernel::SSE2:
+    return executable_sse2(bid_prefix, bid_quantity, ask_prefix, total_bid,
+                           demand, volume, n);
+#endif
+  default:
+    return executable_scalar(bid_prefix, bid_quantity, ask_prefix, total_bid,
+                             demand, volume, n);
+  }
+}
+
+} // namespace
+
+AuctionKernel detected_auction_kernel() {
+#ifdef HFT_X86_SIMD
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2 ? AuctionKernel::AVX2 : AuctionKernel::SSE2;
+#else
+  return AuctionKernel::Scalar;
+#endif
+}
+
+AuctionKernel auction_kernel() {
+  return active_kernel().load(std::memory_order_relaxed);
+}
+
+bool set_auction_kernel(AuctionKernel kernel) {
+  // Each kernel's instruction set includes the one below it
+  if (kernel > detected_auction_kernel()) {
+    return false;
+  }
+  active_kernel().store(kernel, std::memory_order_relaxed);
+  return true;
+}
+
+void prefix_sum(const uint64_t *in, uint64_t *out, size_t n) {
+  switch (auction_kernel()) {
+#ifdef HFT_X86_SIMD
+  case AuctionKernel::AVX2:
+    prefix_sum_avx2(in, out, n);
+    break;
+  case AuctionKernel::SSE2:
+    prefix_sum_sse2(in, out, n);
+    break;
+#endif
+  default:
+    prefix_sum_scalar(in, out, n);
+    break;
+  }
+}
+
+AuctionResult find_equilibrium(const uint64_t *prices,
+                               const uint64_t *bid_quantity,
+                               const uint64_t *ask_quantity, size_t n,
+                               uint64_t reference_price) {
+  if (n == 0) {
+    return {};
+  }
+
+  std::vector<uint64_t> scratch(4 * n);
+  uint64_t *bid_prefix = scratch.data();
+  uint64_t *ask_prefix = bid_prefix + n; // Supply curve
+  uint64_t *demand = ask_prefix + n;     // Demand curve
+  uint64_t *volume = demand + n;
+
+  prefix_sum(bid_quantity, bid_prefix, n);
+  prefix_sum(ask_quantity, ask_prefix, n);
+  uint64_t total_bid = bid_prefix[n - 1];
+
+  uint64_t max_volume = executable(bid_prefix, bid_quantity, ask_prefix,
+                                   total_bid, demand, volume, n);
+
+  if (max_volume == 0) {
+    return {};
+  }
+
+  // Tie-breaks only look at the prices that reach the maximum volume
+  size_t best = n;
+  uint64_t best_surplus = 0;
+  uint64_t best_distance = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (volume[i] != max_volume) {
+      continue;
+    }
+
+    uint64_t surplus = demand[i] > ask_prefix[i] ? demand[i] - ask_prefix[i]
+                                                 : ask_prefix[i] - demand[i];
+    uint64_t distance = 0;
+    if (reference_price > 0) {
+      distance = prices[i] > reference_price ? prices[i] - reference_price
+                                             : reference_price - prices[i];
+    }
+
+    if (best == n || surplus < best_surplus ||
+        (surplus == best_surplus && distance < best_distance)) {
+      best = i;
+      best_surplus = surplus;
+      best_distance = distance;
+    }
+  }
+
+  return {prices[best], max_volume,
+          static_cast<int64_t>(demand[best]) -
+              static_cast<int64_t>(ask_prefix[best])};
+}
+
+} // namespace hft
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hft {
+
+// Outcome of an auction uncross
+struct AuctionResult {
+  uint64_t price = 0;    // Equilibrium price, 0 when nothing crosses
+  uint64_t volume = 0;   // Quantity executed at that price
+  int64_t imbalance = 0; // Demand minus supply at that price
+};
+
+// Instruction set of the prefix_sum / find_equilibrium kernels
+enum class AuctionKernel : uint8_t { Scalar, SSE2, AVX2 };
+
+// Best kernel for this CPU: AVX2 when present, else SSE2 on x86-64, else
+// scalar. It is the one in use unless set_auction_kernel overrides it.
+AuctionKernel detected_auction_kernel();
+AuctionKernel auction_kernel();
+
+// Force a kernel (tests and benchmarks compare them); false and no change
+// when the CPU or build cannot run it
+bool set_auction_kernel(AuctionKernel kernel);
+
+// Inclusive prefix sum of n values (out may alias in), with the selected
+// auction_kernel().
+void prefix_sum(const uint64_t *in, uint64_t *out, size_t n);
+
+// Equilibrium price search over cumulative supply/demand curves.
+//
+// prices must be ascending; bid_quantity/ask_quantity hold the quantity
+// resting at each price. Demand at p is all bid quantity priced >= p, supply
+// is all ask quantity priced <= p. The chosen price maximises executable
+// volume min(demand, supply); ties go to the smallest absolute imbalance,
+// then to the price closest to reference_price (if non-zero), then to the
+// lowest price. The curves are evaluated with auction_kernel(), like
+// prefix_sum.
+AuctionResult find_equilibrium(const uint64_t *prices,
+                               const uint64_t *bid_quantity,
+                               const uint64_t *ask_quantity, size_t n,
+                               uint64_t reference_price);
+
+} // namespace hft
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "benchmark/perf_counters.hpp"
+#include <benchmark/benchmark.h>
+#include <iostream>
+
+namespace hft {
+
+// Hardware counters for one google-benchmark run. Construct right before
+// the timing loop; at scope exit each available event is added to
+// state.counters as a per-iteration average, so it prints next to the time
+// columns. Use pause()/resume() in place of PauseTiming()/ResumeTiming() so
+// untimed setup is not counted either. Without counters the benchmark runs
+// unchanged and a single warning is printed.
+class BenchmarkPerfCounters {
+private:
+  benchmark::State &state_;
+  PerfCounters counters_;
+
+public:
+  explicit BenchmarkPerfCounters(benchmark::State &state) : state_(state) {
+    static bool warned = false;
+    if (!counters_.available() && !warned) {
+      std::cerr << "Hardware counters unavailable ("
+                << PerfCounters::unavailable_reason()
+                << "), reporting times only\n";
+      warned = true;
+    }
+    counters_.start();
+  }
+
+  ~BenchmarkPerfCounters() {
+    PerfSample sample = counters_.stop();
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+      if (sample.valid[i]) {
+        state_.counters[PerfCounters::name(static_cast<PerfEvent>(i))] =
+            benchmark::Counter(static_cast<double>(sample.values[i]),
+                               benchmark::Counter::kAvgIterations);
+      }
+    }
+    if (sample.has(PerfEvent::Cycles) && sample.has(PerfEvent::Instructions) &&
+        sample[PerfEvent::Cycles] > 0) {
+      state_.counters["IPC"] =
+          static_cast<double>(sample[PerfEvent::Instructions]) /
+          static_cast<double>(sample[PerfEvent::Cycles]);
+    }
+  }
+
+  BenchmarkPerfCounters(const BenchmarkPerfCounters &) = delete;
+  BenchmarkPerfCounters &operator=(const BenchmarkPerfCounters &) = delete;
+
+  void pause() {
+    state_.PauseTiming();
+    counters_.pause();
+  }
+
+  void resume() {
+    counters_.resume();
+    state_.ResumeTiming();
+  }
+};
+
+} // namespace hft
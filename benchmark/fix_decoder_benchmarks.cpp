@@ -0,0 +1,157 @@
+#include "benchmark/benchmark_perf.hpp"
+#include "fix/fix_decoder.hpp"
+#include "fix/fix_order_entry.hpp"
+#include "order_book_manager.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace {
+
+std::string frame(const std::string& body) {
+    std::string message = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    unsigned sum = 0;
+    for (unsigned char c : message) sum += c;
+    char trailer[8];
+    snprintf(trailer, sizeof(trailer), "10=%03u\x01", sum % 256);
+    return message + trailer;
+}
+
+// Order flow shaped like a recorded session: full session headers, mostly
+// new orders, some cancels and cancel/replaces of recent orders
+std::string recorded_session(size_t messages) {
+    static const char* symbols[] = {"AAPL", "MSFT", "NVDA", "AMZN"};
+    std::mt19937 rng(1);
+    std::string stream;
+
+    for (size_t i = 1; i <= messages; ++i) {
+        const char* symbol = symbols[i % 4];
+        const char* side = i % 3 ? "1" : "2";
+        char price[32];
+        unsigned whole = static_cast<unsigned>(100 + rng() % 50);
+        unsigned cents = static_cast<unsigned>(rng() % 100);
+        snprintf(price, sizeof(price), "%u.%02u", whole, cents);
+        std::string header = "49=STRAT01\x01" "56=HFTENGINE\x01" "34=" + std::to_string(i) +
+                             "\x01" "52=20240102-14:30:01.123456\x01";
+        std::string id = std::to_string(i);
+        std::string previous = std::to_string(i > 4 ? i - 4 : 1);
+
+        std::string body;
+        switch (rng() % 10) {
+        case 0: case 1:
+            body = "35=F\x01" + header + "11=" + id + "\x01" "41=" + previous +
+                   "\x01" "55=" + symbol + "\x01" "54=" + side + "\x01" "60=20240102-14:30:01.123\x01";
+            break;
+        case 2:
+            body = "35=G\x01" + header + "11=" + id + "\x01" "41=" + previous +
+                   "\x01" "55=" + symbol + "\x01" "54=" + side + "\x01" "38=200\x01" "40=2\x01" "44=" +
+                   price + "\x01" "59=0\x01" "60=20240102-14:30:01.123\x01";
+            break;
+        default:
+            body = "35=D\x01" + header + "11=" + id + "\x01" "1=ACCT42\x01" "21=1\x01" "55=" + symbol +
+                   "\x01" "54=" + side + "\x01" "60=20240102-14:30:01.123\x01" "38=100\x01" "40=2\x01" "44=" +
+                   price + "\x01" "59=0\x01";
+            break;
+        }
+        stream += frame(body);
+    }
+    return stream;
+}
+
+// What an out-of-process parser typically does: split into a map of
+// strings, then convert with the standard library
+bool naive_decode(const std::string& stream, size_t& offset, hft::FixOrder& order) {
+    size_t end = stream.find("\x01" "10=", offset);
+    if (end == std::string::npos) return false;
+    end = stream.find('\x01', end + 1);
+
+    std::map<int, std::string> fields;
+    size_t pos = offset;
+    while (pos <= end) {
+        size_t soh = stream.find('\x01', pos);
+        size_t eq = stream.find('=', pos);
+        fields[std::stoi(stream.substr(pos, eq - pos))] = stream.substr(eq + 1, soh - eq - 1);
+        pos = soh + 1;
+    }
+
+    unsigned sum = 0;
+    size_t checksum_at = stream.rfind("10=", end);
+    for (size_t i = offset; i < checksum_at; ++i) sum += static_cast<unsigned char>(stream[i]);
+    bool ok = sum % 256 == std::stoul(fields[10]);
+
+    const std::string& type = fields[35];
+    order.type = type == "D" ? hft::FixMsgType::NewOrderSingle
+               : type == "F" ? hft::FixMsgType::OrderCancelRequest
+                             : hft::FixMsgType::OrderCancelReplaceRequest;
+    order.cl_ord_id = std::stoull(fields[11]);
+    if (fields.count(41)) order.orig_cl_ord_id = std::stoull(fields[41]);
+    order.side = fields[54] == "2" ? hft::Side::Sell : hft::Side::Buy;
+    if (fields.count(38)) order.quantity = std::stoul(fields[38]);
+    if (fields.count(44)) order.price = std::llround(std::stod(fields[44]) * 100);
+
+    offset = end + 1;
+    return ok;
+}
+
+} // namespace
+
+static void BM_FixDecode(benchmark::State& state) {
+    std::string stream = recorded_session(1024);
+    hft::FixOrder order;
+
+    hft::BenchmarkPerfCounters perf(state);
+
+    for (auto _ : state) {
+        size_t offset = 0, consumed = 0;
+        while (offset < stream.size()) {
+            hft::decode_fix(stream.data() + offset, stream.size() - offset, order, consumed);
+            benchmark::DoNotOptimize(order);
+            offset += consumed;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(BM_FixDecode);
+
+static void BM_FixDecodeNaive(benchmark::State& state) {
+    std::string stream = recorded_session(1024);
+    hft::FixOrder order;
+
+    hft::BenchmarkPerfCounters perf(state);
+
+    for (auto _ : state) {
+        size_t offset = 0;
+        while (offset < stream.size()) {
+            naive_decode(stream, offset, order);
+            benchmark::DoNotOptimize(order);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(BM_FixDecodeNaive);
+
+// Decode plus engine: every message applied to the books
+static void BM_FixOrderEntry(benchmark::State& state) {
+    std::string stream = recorded_session(1024);
+    std::unique_ptr<hft::OrderBookManager> manager;
+
+    hft::BenchmarkPerfCounters perf(state);
+
+    for (auto _ : state) {
+        perf.pause();
+        manager = std::make_unique<hft::OrderBookManager>();
+        hft::FixOrderEntry<hft::OrderBookManager> entry(*manager);
+        perf.resume();
+
+        entry.on_data(stream.data(), stream.size());
+        benchmark::DoNotOptimize(entry.rejected_orders());
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_FixOrderEntry);
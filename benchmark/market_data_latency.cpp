@@ -0,0 +1,146 @@
+#include "market_data/md_consumer.hpp"
+#include "market_data/md_publisher.hpp"
+#include "order_book.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sched.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// Cross-process publish-to-consume latency of the shared-memory market-data
+// ring. The parent drives an OrderBook whose listener publishes into the ring;
+// a forked consumer process polls it and measures steady_clock deltas. The
+// two processes are pinned to different cores when the machine has them.
+//
+// Usage: HFTMarketDataLatency [orders] [publisher_cpu] [consumer_cpu]
+
+namespace {
+
+constexpr const char *RING_NAME = "/hft_md_latency";
+
+uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool pin_to_cpu(int cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+int run_consumer(uint64_t last_sequence, int cpu, int ready_fd) {
+  if (!pin_to_cpu(cpu)) {
+    std::cerr << "consumer: could not pin to cpu " << cpu << "\n";
+  }
+
+  hft::MarketDataConsumer consumer;
+  if (!consumer.open(RING_NAME)) {
+    std::cerr << "consumer: could not attach to ring\n";
+    return 1;
+  }
+
+  char ready = 1;
+  [[maybe_unused]] ssize_t w = write(ready_fd, &ready, 1);
+
+  std::vector<uint64_t> latencies;
+  latencies.reserve(last_sequence);
+  hft::MarketDataUpdate update;
+
+  while (consumer.next_sequence() <= last_sequence) {
+    if (consumer.poll(update) == hft::PollResult::Update) {
+      latencies.push_back(now_ns() - update.publish_ns);
+    }
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  auto pct = [&](double p) {
+    return latencies.empty()
+               ? 0
+               : latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+  };
+
+  std::cout << "Received: " << latencies.size() << " | Lost: "
+            << consumer.lost_updates() << " | Overruns: "
+            << consumer.overruns() << "\n";
+  std::cout << "Publish-to-consume ns  p50: " << pct(0.50)
+            << "  p90: " << pct(0.90) << "  p99: " << pct(0.99)
+            << "  p99.9: " << pct(0.999)
+            << "  max: " << (latencies.empty() ? 0 : latencies.back())
+            << std::endl; // Child leaves via _exit, flush now
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  uint64_t orders = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  int publisher_cpu = argc > 2 ? std::atoi(argv[2]) : 0;
+  int consumer_cpu = argc > 3 ? std::atoi(argv[3]) : (cpus > 1 ? 1 : 0);
+
+  if (publisher_cpu == consumer_cpu) {
+    std::cerr << "warning: publisher and consumer share cpu " << consumer_cpu
+              << ", latencies include scheduling\n";
+  }
+
+  hft::MarketDataPublisher publisher;
+  if (!publisher.open(RING_NAME, 1 << 16)) {
+    std::cerr << "Could not create shared memory ring " << RING_NAME << "\n";
+    return 1;
+  }
+
+  hft::OrderPool pool(1024);
+  hft::BasicOrderBook<hft::MarketDataListener> book(
+      "AAPL", pool, hft::MarketDataListener{{}, &publisher});
+
+  // Each add and each cancel of a top-of-book order publishes a level update
+  // followed by a top-of-book update
+  uint64_t last_sequence = orders * 4;
+
+  int ready_pipe[2];
+  if (pipe(ready_pipe) < 0) {
+    return 1;
+  }
+
+  pid_t child = fork();
+  if (child == 0) {
+    close(ready_pipe[0]);
+    _exit(run_consumer(last_sequence, consumer_cpu, ready_pipe[1]));
+  }
+
+  close(ready_pipe[1]);
+  pin_to_cpu(publisher_cpu);
+  char ready;
+  if (read(ready_pipe[0], &ready, 1) != 1) {
+    std::cerr << "Consumer failed to start\n";
+    waitpid(child, nullptr, 0);
+    return 1;
+  }
+
+  // Pace the producer a little so the numbers show latency, not overruns
+  uint64_t start = now_ns();
+  for (uint64_t i = 0; i < orders; ++i) {
+    book.add_order(i + 1, 100'00 + (i % 2), 10, 0, hft::Side::Buy);
+    book.cancel_order(i + 1);
+
+    uint64_t until = now_ns() + 200;
+    while (now_ns() < until) {
+    }
+  }
+  uint64_t elapsed = now_ns() - start;
+
+  int status = 0;
+  waitpid(child, &status, 0);
+
+  std::cout << "Published: " << publisher.last_sequence() << " updates in "
+            << elapsed / 1000 << " us\n";
+  return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
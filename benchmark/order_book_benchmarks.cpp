@@ -1,15 +1,93 @@
+#include "benchmark/benchmark_perf.hpp"
+#include "consolidated_book.hpp"
 #include "order_book.hpp"
+#include "order_book_manager.hpp"
 #include "order_pool.hpp"
+#include "pre_trade_risk.hpp"
 #include <benchmark/benchmark.h>
+#include <memory>
 
 static void BM_AddOrder(benchmark::State& state) {
     hft::OrderPool pool;
     hft::OrderBook book("AAPL", pool);
 
+    hft::BenchmarkPerfCounters perf(state);
+
     for (auto _ : state) {
         book.add_order(state.range(0), 150'00, 100, 1, hft::Side::Buy);
     }
 }
 BENCHMARK(BM_AddOrder)->Arg(1)->Arg(1000);
 
+static void BM_ConsolidatedLevelUpdate(benchmark::State& state) {
+    hft::ConsolidatedBook nbbo(140'00);
+    uint64_t i = 0;
+
+    hft::BenchmarkPerfCounters perf(state);
+
+    for (auto _ : state) {
+        uint8_t venue = i % hft::MAX_VENUES;
+        nbbo.on_level_change(venue, hft::Side::Buy, 150'00 + (i % 64), i & 0xff);
+        benchmark::DoNotOptimize(nbbo.get_best_bid());
+        ++i;
+    }
+}
+BENCHMARK(BM_ConsolidatedLevelUpdate);
+
+// Add-then-cancel through the manager, with and without the risk stage
+template <typename Manager>
+static void BM_ManagerOrderRoundTrip(benchmark::State& state) {
+    Manager manager;
+    manager.process_order("AAPL", 1, 149'00, 100, 1, hft::OrderType::Limit, hft::Side::Buy);
+    manager.process_order("AAPL", 2, 151'00, 100, 2, hft::OrderType::Limit, hft::Side::Sell);
+    uint64_t id = 3;
+
+    hft::BenchmarkPerfCounters perf(state);
+
+    for (auto _ : state) {
+        manager.process_order("AAPL", id, 150'00, 10, 3, hft::OrderType::Limit, hft::Side::Buy, 1);
+        manager.process_order("AAPL", id, 0, 0, 3, hft::OrderType::Cancel, hft::Side::Buy, 1);
+        ++id;
+    }
+}
+BENCHMARK_TEMPLATE(BM_ManagerOrderRoundTrip, hft::OrderBookManager);
+BENCHMARK_TEMPLATE(BM_ManagerOrderRoundTrip,
+                   hft::BasicOrderBookManager<hft::NullOrderBookListener, hft::PreTradeRisk>);
+
+// Open with range(0) orders per side crossing over 100 overlapping prices:
+// single-price uncross vs pairwise continuous matching
+template <bool Auction>
+static void BM_OpeningCross(benchmark::State& state) {
+    const uint64_t orders = state.range(0);
+    std::unique_ptr<hft::OrderPool> pool;
+    std::unique_ptr<hft::OrderBook> book;
+
+    hft::BenchmarkPerfCounters perf(state);
+
+    for (auto _ : state) {
+        perf.pause();
+        // Tear down the previous round outside the timed region. The book
+        // does not hand its unfilled orders back, so the pool goes with it.
+        book.reset();
+        pool = std::make_unique<hft::OrderPool>(2 * orders + 16);
+        book = std::make_unique<hft::OrderBook>("AAPL", *pool);
+        book->set_auction_mode(true);
+        for (uint64_t i = 0; i < orders; ++i) {
+            book->add_order(2 * i + 1, 150'00 + (i * 7) % 100, 10 + i % 90, i, hft::Side::Buy);
+            book->add_order(2 * i + 2, 149'50 + (i * 13) % 100, 10 + i % 70, i, hft::Side::Sell);
+        }
+        perf.resume();
+
+        if constexpr (Auction) {
+            benchmark::DoNotOptimize(book->uncross());
+        } else {
+            book->set_auction_mode(false);
+            book->match_orders();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * orders * 2);
+}
+BENCHMARK_TEMPLATE(BM_OpeningCross, true)->Arg(1000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_OpeningCross, false)->Arg(1000)->Arg(10000);
+
 BENCHMARK_MAIN();
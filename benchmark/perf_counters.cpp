@@ -0,0 +1,225 @@
+#include "benchmark/perf_counters.hpp"
+#include <sstream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace hft {
+
+namespace {
+
+constexpr const char *EVENT_NAMES[PERF_EVENT_COUNT] = {
+    "cycles", "instructions", "L1D-misses",
+    "LLC-misses", "dTLB-misses", "branch-misses"};
+
+#ifdef __linux__
+
+constexpr uint64_t cache_event(uint64_t cache, uint64_t op, uint64_t result) {
+  return cache | (op << 8) | (result << 16);
+}
+
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+// Same order as PerfEvent
+constexpr EventConfig EVENT_CONFIGS[PERF_EVENT_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE,
+     cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                 PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HW_CACHE,
+     cache_event(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                 PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}};
+
+// A grouped event with group_fd -1 is the group leader; members are opened
+// enabled and count whenever the leader does
+int open_event(const EventConfig &event, bool grouped = false,
+               int group_fd = -1) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = group_fd < 0;
+  attr.inherit = 1; // Follow worker threads started while counting
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  if (grouped) {
+    attr.read_format |= PERF_FORMAT_GROUP;
+  }
+
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+// Grouped events are driven through the leader only
+void control(const std::array<int, PERF_EVENT_COUNT> &fds,
+             const std::array<bool, PERF_EVENT_COUNT> &grouped,
+             unsigned long request) {
+  for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+    if (fds[i] < 0) {
+      continue;
+    }
+    if (!grouped[i]) {
+      ioctl(fds[i], request, 0);
+    } else if (i == 0) {
+      ioctl(fds[i], request, PERF_IOC_FLAG_GROUP);
+    }
+  }
+}
+
+#endif // __linux__
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+#ifdef __linux__
+  int leader = open_event(EVENT_CONFIGS[0], true);
+  grouped_[0] = leader >= 0;
+  for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+    int fd = i == 0 ? leader : -1;
+    if (i > 0 && leader >= 0) {
+      fd = open_event(EVENT_CONFIGS[i], true, leader);
+      grouped_[i] = fd >= 0;
+    }
+    if (fd < 0) {
+      fd = open_event(EVENT_CONFIGS[i]); // Counted on its own
+    }
+    fds_[i] = fd;
+    available_ |= fd >= 0;
+  }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+  control(fds_, grouped_, PERF_EVENT_IOC_RESET);
+  control(fds_, grouped_, PERF_EVENT_IOC_ENABLE);
+#endif
+}
+
+void PerfCounters::pause() {
+#ifdef __linux__
+  control(fds_, grouped_, PERF_EVENT_IOC_DISABLE);
+#endif
+}
+
+void PerfCounters::resume() {
+#ifdef __linux__
+  control(fds_, grouped_, PERF_EVENT_IOC_ENABLE);
+#endif
+}
+
+PerfSample PerfCounters::stop() {
+  PerfSample sample;
+#ifdef __linux__
+  pause();
+
+  // Group layout: member count, time enabled, time running, then one value
+  // per member in the order they were opened (leader first)
+  uint64_t group[3 + PERF_EVENT_COUNT];
+  ssize_t bytes = grouped_[0] ? read(fds_[0], group, sizeof(group)) : -1;
+  if (bytes >= static_cast<ssize_t>(3 * sizeof(uint64_t)) && group[2] != 0) {
+    double scale =
+        static_cast<double>(group[1]) / static_cast<double>(group[2]);
+    size_t member = 0;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+      if (!grouped_[i]) {
+        continue;
+      }
+      if (member < group[0] &&
+          bytes >= static_cast<ssize_t>((4 + member) * sizeof(uint64_t))) {
+        sample.values[i] = static_cast<uint64_t>(
+            static_cast<double>(group[3 + member]) * scale);
+        sample.valid[i] = true;
+      }
+      ++member;
+    }
+  }
+
+  for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+    uint64_t data[3]; // value, time enabled, time running
+    if (fds_[i] < 0 || grouped_[i] ||
+        read(fds_[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+      continue; // Not opened, or never got a hardware counter
+    }
+
+    double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+    sample.values[i] = static_cast<uint64_t>(static_cast<double>(data[0]) * scale);
+    sample.valid[i] = true;
+  }
+#endif
+  return sample;
+}
+
+const char *PerfCounters::name(PerfEvent event) {
+  return EVENT_NAMES[static_cast<size_t>(event)];
+}
+
+std::string PerfCounters::unavailable_reason() {
+#ifdef __linux__
+  int fd = open_event(EVENT_CONFIGS[0]);
+  if (fd >= 0) {
+    close(fd);
+    return "";
+  }
+  int error = errno;
+
+  int paranoid = -1;
+  std::ifstream("/proc/sys/kernel/perf_event_paranoid") >> paranoid;
+  std::ostringstream reason;
+  reason << "perf_event_open: " << std::strerror(error)
+         << " (perf_event_paranoid=" << paranoid << ")";
+  return reason.str();
+#else
+  return "hardware counters need Linux perf_event_open";
+#endif
+}
+
+std::string format_per_operation(const PerfSample &sample,
+                                 uint64_t operations) {
+  std::ostringstream out;
+  double ops = operations ? static_cast<double>(operations) : 1.0;
+  out.setf(std::ios::fixed);
+  out.precision(2);
+
+  for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+    if (sample.valid[i]) {
+      out << EVENT_NAMES[i] << "/op=" << sample.values[i] / ops << "  ";
+    }
+  }
+  if (sample.has(PerfEvent::Cycles) && sample.has(PerfEvent::Instructions) &&
+      sample[PerfEvent::Cycles] > 0) {
+    out << "IPC="
+        << static_cast<double>(sample[PerfEvent::Instructions]) /
+               static_cast<double>(sample[PerfEvent::Cycles]);
+  }
+  return out.str();
+}
+
+} // namespace hft
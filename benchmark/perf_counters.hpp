@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hft {
+
+enum class PerfEvent : uint8_t {
+  Cycles = 0,
+  Instructions = 1,
+  L1DMisses = 2,
+  LLCMisses = 3,
+  DTLBMisses = 4,
+  BranchMisses = 5
+};
+
+constexpr size_t PERF_EVENT_COUNT = 6;
+
+struct PerfSample {
+  std::array<uint64_t, PERF_EVENT_COUNT> values{};
+  std::array<bool, PERF_EVENT_COUNT> valid{}; // Event opened and scheduled
+
+  uint64_t operator[](PerfEvent event) const {
+    return values[static_cast<size_t>(event)];
+  }
+  bool has(PerfEvent event) const { return valid[static_cast<size_t>(event)]; }
+};
+
+// Hardware counters via perf_event_open (Linux only).
+//
+// Counts user space of the calling thread and of threads it starts while
+// counting, so no root is needed up to perf_event_paranoid 2. Cycles lead an
+// event group that is scheduled and read as one, so ratios such as IPC come
+// from the same interval even under multiplexing. An event that cannot join
+// the group is opened on its own; one the CPU or kernel refuses is simply
+// missing from the sample, and available() is false when none could be
+// opened (containers, VMs without a PMU, other platforms). Multiplexed
+// counts are scaled to the full measurement interval.
+class PerfCounters {
+private:
+  std::array<int, PERF_EVENT_COUNT> fds_;
+  std::array<bool, PERF_EVENT_COUNT> grouped_{}; // Member of the cycles group
+  bool available_ = false;
+
+public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  bool available() const { return available_; }
+
+  // Zero and enable every counter
+  void start();
+  // Stop counting without resetting (e.g. around untimed setup)
+  void pause();
+  void resume();
+  // Disable and read
+  PerfSample stop();
+
+  static const char *name(PerfEvent event);
+
+  // Why available() is false, for a one-line warning
+  static std::string unavailable_reason();
+};
+
+// "cycles=.. instructions=.. IPC=.." per operation, for plain-text reports
+std::string format_per_operation(const PerfSample &sample,
+                                 uint64_t operations);
+
+} // namespace hft
@@ -0,0 +1,135 @@
+#include "benchmark/perf_counters.hpp"
+#include "sim/simulation_runner.hpp"
+#include "sim/synthetic_replay.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Backtest-style replay across many symbols: generates a synthetic session
+// per symbol, runs a queue-joining strategy against each through the
+// exchange simulator (symbols in parallel) and reports throughput, with
+// hardware counters per event for each phase when the machine has them.
+//
+// Usage: HFTReplayDriver [symbols] [events_per_symbol] [threads]
+
+namespace {
+
+// Joins the best bid with 100 and re-joins when the bid moves away
+struct QueueJoiner : hft::NullStrategy {
+  uint64_t working = 0;
+  bool has_order = false;
+  bool cancelling = false;
+  uint64_t filled = 0;
+
+  void on_market_data(hft::ExchangeSimulator &sim,
+                      const hft::SimTopOfBook &top) {
+    if (top.bid_price == 0 || cancelling) {
+      return;
+    }
+    if (!has_order) {
+      working = sim.send_order(hft::Side::Buy, top.bid_price, 100);
+      has_order = true;
+    } else if (sim.order(working).price != top.bid_price) {
+      sim.cancel_order(working);
+      cancelling = true;
+    }
+  }
+
+  void on_fill(hft::ExchangeSimulator &, const hft::SimOrder &order, uint64_t,
+               uint32_t quantity) {
+    filled += quantity;
+    if (order.id == working && order.quantity == 0) {
+      has_order = cancelling = false;
+    }
+  }
+
+  void on_cancel(hft::ExchangeSimulator &, uint64_t order_id) {
+    if (order_id == working) {
+      has_order = cancelling = false;
+    }
+  }
+
+  void on_reject(hft::ExchangeSimulator &sim, uint64_t order_id) {
+    // A cancel that lost the race with a fill is settled by on_fill
+    if (order_id == working && !sim.order(order_id).live &&
+        sim.order(order_id).filled == 0) {
+      has_order = cancelling = false;
+    }
+  }
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  size_t symbols = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+  size_t events = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+  unsigned threads = argc > 3 ? std::atoi(argv[3]) : 0;
+
+  hft::PerfCounters counters;
+  if (!counters.available()) {
+    std::cerr << "Hardware counters unavailable ("
+              << hft::PerfCounters::unavailable_reason()
+              << "), reporting times only\n";
+  }
+
+  counters.start();
+  auto start = std::chrono::steady_clock::now();
+  std::vector<hft::SymbolReplay> replays(symbols);
+  for (size_t i = 0; i < symbols; ++i) {
+    replays[i].symbol = "SYM" + std::to_string(i);
+    replays[i].events = hft::generate_synthetic_replay(i + 1, events);
+  }
+  double generate_seconds = seconds_since(start);
+  hft::PerfSample generate_counters = counters.stop();
+
+  hft::LatencyModel latency;
+  latency.order_entry_ns = 20'000;
+  latency.market_data_ns = 5'000;
+  latency.jitter_ns = 2'000;
+
+  // Worker threads start after the counters, so they are counted too
+  std::vector<QueueJoiner> strategies(symbols);
+  counters.start();
+  start = std::chrono::steady_clock::now();
+  auto stats = hft::simulate_symbols(replays, strategies, latency, threads);
+  double simulate_seconds = seconds_since(start);
+  hft::PerfSample simulate_counters = counters.stop();
+
+  hft::SimStats total;
+  for (const auto &s : stats) {
+    total.replay_events += s.replay_events;
+    total.own_orders += s.own_orders;
+    total.own_fills += s.own_fills;
+    total.own_filled_quantity += s.own_filled_quantity;
+    total.market_data_updates += s.market_data_updates;
+  }
+
+  std::cout << "Symbols: " << symbols << " | Events: " << total.replay_events
+            << " | Generate: " << generate_seconds << " s\n";
+  std::cout << "Simulate: " << simulate_seconds << " s | "
+            << static_cast<uint64_t>(total.replay_events / simulate_seconds)
+            << " events/s\n";
+  if (counters.available()) {
+    std::cout << "Generate per event: "
+              << hft::format_per_operation(generate_counters,
+                                           total.replay_events)
+              << "\n";
+    std::cout << "Simulate per event: "
+              << hft::format_per_operation(simulate_counters,
+                                           total.replay_events)
+              << "\n";
+  }
+  std::cout << "Own orders: " << total.own_orders
+            << " | Fills: " << total.own_fills
+            << " | Filled qty: " << total.own_filled_quantity
+            << " | MD updates: " << total.market_data_updates << "\n";
+  return 0;
+}
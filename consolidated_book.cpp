@@ -0,0 +1,256 @@
+#include "consolidated_book.hpp"
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+
+namespace hft {
+
+ConsolidatedBook::ConsolidatedBook(uint64_t base_price, uint64_t tick_size)
+    : base_price_(base_price), tick_size_(tick_size ? tick_size : 1) {}
+
+ConsolidatedBook::~ConsolidatedBook() {
+  std::array<void *, MAX_VENUES> venues;
+  std::array<void (*)(void *), MAX_VENUES> detachers;
+  size_t count;
+  {
+    std::unique_lock lock(mutex_);
+    venues = venues_;
+    detachers = detachers_;
+    count = venue_count_;
+  }
+
+  // Unsubscribe without holding our lock; the book may be mid-update
+  for (size_t i = 0; i < count; ++i) {
+    if (venues[i]) {
+      detachers[i](venues[i]);
+    }
+  }
+}
+
+ConsolidatedBookListener::~ConsolidatedBookListener() {
+  if (consolidated) {
+    consolidated->detach_venue(venue);
+  }
+}
+
+void ConsolidatedBookListener::on_level_change(std::string_view /*symbol*/,
+                                               Side side, uint64_t price,
+                                               uint64_t quantity) {
+  if (consolidated) {
+    consolidated->on_level_change(venue, side, price, quantity);
+  }
+}
+
+bool ConsolidatedBook::to_slot(uint64_t price, size_t &slot) const {
+  if (price < base_price_) {
+    return false;
+  }
+
+  uint64_t offset = price - base_price_;
+  if (offset % tick_size_ != 0 || offset / tick_size_ >= LADDER_SIZE) {
+    return false;
+  }
+
+  slot = offset / tick_size_;
+  return true;
+}
+
+uint64_t ConsolidatedBook::to_price(size_t slot) const {
+  return base_price_ + slot * tick_size_;
+}
+
+void ConsolidatedBook::update_slot(Slot &s, uint8_t venue, uint64_t quantity) {
+  uint64_t old_quantity = s.venue_quantity[venue];
+
+  s.venue_quantity[venue] = quantity;
+  s.total = s.total - old_quantity + quantity;
+
+  if (quantity > 0) {
+    s.venue_mask |= (1u << venue);
+  } else {
+    s.venue_mask &= ~(1u << venue);
+  }
+}
+
+void ConsolidatedBook::set_quantity(Ladder &ladder, size_t slot, uint8_t venue,
+                                    uint64_t quantity) {
+  Slot &s = ladder.slots[slot];
+  update_slot(s, venue, quantity);
+
+  // Keep the occupancy bitmap in sync so best-price lookups stay O(1)
+  size_t word = slot / 64;
+  uint64_t bit = uint64_t{1} << (slot % 64);
+  if (s.total > 0) {
+    ladder.occupied[word] |= bit;
+    ladder.summary |= uint64_t{1} << word;
+  } else {
+    ladder.occupied[word] &= ~bit;
+    if (ladder.occupied[word] == 0) {
+      ladder.summary &= ~(uint64_t{1} << word);
+    }
+  }
+}
+
+void ConsolidatedBook::set_overflow_quantity(Ladder &ladder, uint64_t price,
+                                             uint8_t venue, uint64_t quantity) {
+  auto it = ladder.overflow.find(price);
+  if (it == ladder.overflow.end()) {
+    if (quantity == 0) {
+      return;
+    }
+    it = ladder.overflow.emplace(price, Slot()).first;
+  }
+
+  update_slot(it->second, venue, quantity);
+  if (it->second.total == 0) {
+    ladder.overflow.erase(it);
+  }
+}
+
+const ConsolidatedBook::Slot *
+ConsolidatedBook::find_level(const Ladder &ladder, uint64_t price) const {
+  size_t slot;
+  if (to_slot(price, slot)) {
+    return &ladder.slots[slot];
+  }
+
+  auto it = ladder.overflow.find(price);
+  return it != ladder.overflow.end() ? &it->second : nullptr;
+}
+
+ConsolidatedQuote ConsolidatedBook::quote_at(const Ladder &ladder,
+                                             size_t slot) const {
+  const Slot &s = ladder.slots[slot];
+  return {to_price(slot), s.total, s.venue_mask};
+}
+
+int ConsolidatedBook::reserve_venue(void *book, void (*detacher)(void *)) {
+  std::unique_lock lock(mutex_);
+
+  if (venue_count_ >= MAX_VENUES) {
+    return -1;
+  }
+  venues_[venue_count_] = book;
+  detachers_[venue_count_] = detacher;
+  return static_cast<int>(venue_count_++);
+}
+
+void ConsolidatedBook::detach_venue(uint8_t venue) {
+  std::unique_lock lock(mutex_);
+
+  if (venue >= venue_count_) {
+    return;
+  }
+  venues_[venue] = nullptr;
+
+  for (Ladder *ladder : {&bids_, &asks_}) {
+    for (size_t slot = 0; slot < LADDER_SIZE; ++slot) {
+      if (ladder->slots[slot].venue_quantity[venue] > 0) {
+        set_quantity(*ladder, slot, venue, 0);
+      }
+    }
+
+    for (auto it = ladder->overflow.begin(); it != ladder->overflow.end();) {
+      update_slot(it->second, venue, 0);
+      it = it->second.total == 0 ? ladder->overflow.erase(it) : std::next(it);
+    }
+  }
+}
+
+bool ConsolidatedBook::on_level_change(uint8_t venue, Side side,
+                                       uint64_t price, uint64_t quantity) {
+  size_t slot;
+  std::unique_lock lock(mutex_);
+
+  if (venue >= MAX_VENUES) {
+    ++dropped_updates_;
+    return false;
+  }
+
+  Ladder &ladder = side == Side::Buy ? bids_ : asks_;
+  if (to_slot(price, slot)) {
+    set_quantity(ladder, slot, venue, quantity);
+  } else {
+    set_overflow_quantity(ladder, price, venue, quantity);
+  }
+  return true;
+}
+
+ConsolidatedQuote ConsolidatedBook::get_best_bid() const {
+  std::shared_lock lock(mutex_);
+
+  ConsolidatedQuote best{0, 0, 0};
+  if (bids_.summary != 0) {
+    // Highest occupied slot
+    size_t word = 63 - __builtin_clzll(bids_.summary);
+    size_t bit = 63 - __builtin_clzll(bids_.occupied[word]);
+    best = quote_at(bids_, word * 64 + bit);
+  }
+
+  if (!bids_.overflow.empty()) {
+    auto it = std::prev(bids_.overflow.end());
+    if (it->first > best.price) {
+      best = {it->first, it->second.total, it->second.venue_mask};
+    }
+  }
+  return best;
+}
+
+ConsolidatedQuote ConsolidatedBook::get_best_ask() const {
+  std::shared_lock lock(mutex_);
+
+  ConsolidatedQuote best{std::numeric_limits<uint64_t>::max(), 0, 0};
+  if (asks_.summary != 0) {
+    // Lowest occupied slot
+    size_t word = __builtin_ctzll(asks_.summary);
+    size_t bit = __builtin_ctzll(asks_.occupied[word]);
+    best = quote_at(asks_, word * 64 + bit);
+  }
+
+  if (!asks_.overflow.empty()) {
+    auto it = asks_.overflow.begin();
+    if (it->first < best.price) {
+      best = {it->first, it->second.total, it->second.venue_mask};
+    }
+  }
+  return best;
+}
+
+ConsolidatedQuote ConsolidatedBook::get_level(Side side, uint64_t price) const {
+  std::shared_lock lock(mutex_);
+
+  const Slot *s = find_level(side == Side::Buy ? bids_ : asks_, price);
+  if (!s) {
+    return {price, 0, 0};
+  }
+  return {price, s->total, s->venue_mask};
+}
+
+uint64_t ConsolidatedBook::get_venue_quantity(uint8_t venue, Side side,
+                                              uint64_t price) const {
+  std::shared_lock lock(mutex_);
+
+  if (venue >= MAX_VENUES) {
+    return 0;
+  }
+  const Slot *s = find_level(side == Side::Buy ? bids_ : asks_, price);
+  return s ? s->venue_quantity[venue] : 0;
+}
+
+size_t ConsolidatedBook::venue_count() const {
+  std::shared_lock lock(mutex_);
+  return venue_count_;
+}
+
+uint64_t ConsolidatedBook::dropped_updates() const {
+  std::shared_lock lock(mutex_);
+  return dropped_updates_;
+}
+
+size_t ConsolidatedBook::overflow_levels() const {
+  std::shared_lock lock(mutex_);
+  return bids_.overflow.size() + asks_.overflow.size();
+}
+
+} // namespace hft
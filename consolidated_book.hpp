@@ -0,0 +1,158 @@
+#pragma once
+
+#include "enums.hpp"
+#include "order.hpp"
+#include "order_book_listener.hpp"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace hft {
+
+// Constants for the consolidated ladder
+constexpr size_t MAX_VENUES = 8;
+constexpr size_t LADDER_WORDS = 64;
+constexpr size_t LADDER_SIZE = LADDER_WORDS * 64; // One bit per tick slot
+
+// Aggregated view of one price across all venues
+struct ConsolidatedQuote {
+  uint64_t price;
+  uint64_t quantity;
+  uint32_t venue_mask; // Bit v set when venue v has quantity at this price
+};
+
+class ConsolidatedBook;
+
+// Book listener that forwards level changes of one venue to a ConsolidatedBook.
+// The attachment belongs to a single book, so copies start detached.
+struct ConsolidatedBookListener : NullOrderBookListener {
+  ConsolidatedBook *consolidated = nullptr;
+  uint8_t venue = 0;
+
+  ConsolidatedBookListener() = default;
+  ConsolidatedBookListener(const ConsolidatedBookListener &) {}
+  ConsolidatedBookListener &operator=(const ConsolidatedBookListener &) {
+    return *this;
+  }
+  ~ConsolidatedBookListener();
+
+  void on_level_change(std::string_view symbol, Side side, uint64_t price,
+                       uint64_t quantity);
+};
+
+// Consolidated (NBBO) book for one instrument quoted on several venues.
+//
+// Each venue is a book whose listener derives from ConsolidatedBookListener,
+// so it pushes its level changes here. Prices are mapped onto a fixed ladder
+// of LADDER_SIZE ticks starting at base_price, so every update is a direct
+// slot write plus a two-level occupancy bitmap update, and the best bid/offer
+// is found with a couple of bit scans instead of re-merging the venue books.
+// Levels that fall off the ladder (below base_price, beyond LADDER_SIZE ticks
+// or between ticks) are kept in a sorted overflow map per side, so they still
+// count toward the best bid/offer; only the ladder path is constant time.
+class ConsolidatedBook {
+private:
+  struct Slot {
+    uint64_t total = 0;
+    uint32_t venue_mask = 0;
+    std::array<uint64_t, MAX_VENUES> venue_quantity{};
+  };
+
+  struct Ladder {
+    std::vector<Slot> slots;
+    std::array<uint64_t, LADDER_WORDS> occupied{}; // Bit per non-empty slot
+    uint64_t summary = 0;                          // Bit per non-zero word
+    std::map<uint64_t, Slot> overflow;             // Off-ladder levels by price
+
+    Ladder() : slots(LADDER_SIZE) {}
+  };
+
+  uint64_t base_price_;
+  uint64_t tick_size_;
+  Ladder bids_;
+  Ladder asks_;
+  std::array<void *, MAX_VENUES> venues_{};
+  std::array<void (*)(void *), MAX_VENUES> detachers_{};
+  size_t venue_count_ = 0;
+  uint64_t dropped_updates_ = 0;
+  mutable std::shared_mutex mutex_; // Read-write lock for thread safety
+
+  // Internal methods
+  bool to_slot(uint64_t price, size_t &slot) const;
+  uint64_t to_price(size_t slot) const;
+  static void update_slot(Slot &s, uint8_t venue, uint64_t quantity);
+  void set_quantity(Ladder &ladder, size_t slot, uint8_t venue,
+                    uint64_t quantity);
+  void set_overflow_quantity(Ladder &ladder, uint64_t price, uint8_t venue,
+                             uint64_t quantity);
+  const Slot *find_level(const Ladder &ladder, uint64_t price) const;
+  ConsolidatedQuote quote_at(const Ladder &ladder, size_t slot) const;
+  int reserve_venue(void *book, void (*detacher)(void *));
+
+public:
+  ConsolidatedBook(uint64_t base_price, uint64_t tick_size = 1);
+  ~ConsolidatedBook();
+
+  ConsolidatedBook(const ConsolidatedBook &) = delete;
+  ConsolidatedBook &operator=(const ConsolidatedBook &) = delete;
+
+  // Subscribe to a venue book; returns the venue id, or -1 when full or the
+  // book already feeds a consolidated book (the other one's teardown would
+  // otherwise unhook it from this one)
+  template <typename Book> int add_venue(Book &book) {
+    int venue = -1;
+
+    // Check, reserve and attach under the book lock; the book replays its
+    // resting levels as part of attaching
+    book.reconfigure_listener([this, &book, &venue](ConsolidatedBookListener &l) {
+      if (l.consolidated) {
+        return;
+      }
+      venue = reserve_venue(&book, [](void *b) {
+        static_cast<Book *>(b)->reconfigure_listener(
+            [](ConsolidatedBookListener &l) { l.consolidated = nullptr; });
+      });
+      if (venue >= 0) {
+        l.consolidated = this;
+        l.venue = static_cast<uint8_t>(venue);
+      }
+    });
+    return venue;
+  }
+
+  template <typename Manager>
+  int add_venue(Manager &manager, const std::string &symbol) {
+    return add_venue(*manager.get_order_book(symbol));
+  }
+
+  // Forget every level of a venue (called when its book goes away)
+  void detach_venue(uint8_t venue);
+
+  // Level-change entry point: new aggregate quantity of a venue at a price,
+  // 0 when the level was removed. Returns false for an unknown venue id.
+  bool on_level_change(uint8_t venue, Side side, uint64_t price,
+                       uint64_t quantity);
+
+  // Best bid/offer across venues. Empty sides follow OrderBook conventions
+  // (bid price 0, ask price max) with zero quantity.
+  ConsolidatedQuote get_best_bid() const;
+  ConsolidatedQuote get_best_ask() const;
+
+  // Aggregated level and per-venue attribution at a price
+  ConsolidatedQuote get_level(Side side, uint64_t price) const;
+  uint64_t get_venue_quantity(uint8_t venue, Side side, uint64_t price) const;
+
+  size_t venue_count() const;
+
+  // Updates ignored because the venue id was out of range
+  uint64_t dropped_updates() const;
+
+  // Levels currently held outside the ladder (both sides). A persistently
+  // non-zero value means base_price/tick_size no longer fit the market.
+  size_t overflow_levels() const;
+};
+
+} // namespace hft
@@ -14,4 +14,21 @@ enum class OrderType : uint8_t {
   Cancel = 2 // TODO: think I can probably get rid of this
 };
 
+enum class RejectReason : uint8_t {
+  DuplicateOrderId = 0,
+  UnknownOrder = 1,
+  TooManyPriceLevels = 2,
+  PriceLevelFull = 3,
+  UnsupportedOrderType = 4,
+  UnknownAccount = 5,
+  RiskMaxQuantity = 6,
+  RiskPriceBand = 7,
+  RiskPosition = 8,
+  RiskOpenNotional = 9,
+  InvalidMessage = 10,
+  NoLiquidity = 11,
+  AuctionInProgress = 12,
+  ReplaceBelowFilled = 13 // Replace quantity not above what already executed
+};
+
 } // namespace hft
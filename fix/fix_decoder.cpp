@@ -0,0 +1,341 @@
+#include "fix/fix_decoder.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define HFT_X86_SIMD 1
+#endif
+
+namespace hft {
+
+namespace {
+
+constexpr size_t NO_POSITION = static_cast<size_t>(-1);
+
+constexpr uint64_t price_scale(uint32_t decimals) {
+  uint64_t scale = 1;
+  for (uint32_t i = 0; i < decimals; ++i) {
+    scale *= 10;
+  }
+  return scale;
+}
+
+// Bit i set when byte i of a 64-byte block is SOH / '='
+struct DelimiterMasks {
+  uint64_t soh = 0;
+  uint64_t equals = 0;
+};
+
+using ScanFn = DelimiterMasks (*)(const char *);
+
+#ifdef HFT_X86_SIMD
+
+DelimiterMasks scan_sse2(const char *p) {
+  const __m128i soh = _mm_set1_epi8(FIX_SOH);
+  const __m128i equals = _mm_set1_epi8('=');
+  DelimiterMasks masks;
+
+  for (int i = 0; i < 4; ++i) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * i));
+    masks.soh |= static_cast<uint64_t>(static_cast<uint16_t>(
+                     _mm_movemask_epi8(_mm_cmpeq_epi8(x, soh))))
+                 << (16 * i);
+    masks.equals |= static_cast<uint64_t>(static_cast<uint16_t>(
+                        _mm_movemask_epi8(_mm_cmpeq_epi8(x, equals))))
+                    << (16 * i);
+  }
+  return masks;
+}
+
+__attribute__((target("avx2"))) uint64_t
+match_mask_avx2(__m256i lo, __m256i hi, __m256i needle) {
+  uint64_t low =
+      static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+  uint64_t high =
+      static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+  return low | (high << 32);
+}
+
+__attribute__((target("avx2"))) DelimiterMasks scan_avx2(const char *p) {
+  __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+
+  DelimiterMasks masks;
+  masks.soh = match_mask_avx2(lo, hi, _mm256_set1_epi8(FIX_SOH));
+  masks.equals = match_mask_avx2(lo, hi, _mm256_set1_epi8('='));
+  return masks;
+}
+
+ScanFn select_scan() {
+  return __builtin_cpu_supports("avx2") ? scan_avx2 : scan_sse2;
+}
+
+#else
+
+DelimiterMasks scan_scalar(const char *p) {
+  DelimiterMasks masks;
+  for (int i = 0; i < 64; ++i) {
+    masks.soh |= static_cast<uint64_t>(p[i] == FIX_SOH) << i;
+    masks.equals |= static_cast<uint64_t>(p[i] == '=') << i;
+  }
+  return masks;
+}
+
+ScanFn select_scan() { return scan_scalar; }
+
+#endif // HFT_X86_SIMD
+
+// Sum of the bytes in [p, p + n), for CheckSum(10)
+uint32_t byte_sum(const char *p, size_t n) {
+  uint64_t sum = 0;
+  size_t i = 0;
+
+#ifdef HFT_X86_SIMD
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc = zero;
+  for (; i + 16 <= n; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(x, zero));
+  }
+  sum = static_cast<uint64_t>(_mm_cvtsi128_si64(acc)) +
+        static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc)));
+#endif
+
+  for (; i < n; ++i) {
+    sum += static_cast<uint8_t>(p[i]);
+  }
+  return static_cast<uint32_t>(sum);
+}
+
+// Digit conversions accumulate a single error flag instead of branching on
+// every character; ok is only ever cleared
+uint64_t parse_uint(std::string_view s, bool &ok) {
+  uint64_t value = 0;
+  bool bad = s.empty() || s.size() > 19;
+  for (char c : s) {
+    uint32_t digit = static_cast<uint8_t>(c) - static_cast<uint32_t>('0');
+    bad |= digit > 9;
+    value = value * 10 + digit;
+  }
+  ok &= !bad;
+  return value;
+}
+
+// Decimal price to fixed point; digits past FIX_PRICE_DECIMALS must be zero
+uint64_t parse_price(std::string_view s, bool &ok) {
+  size_t dot = s.find('.');
+  if (dot == std::string_view::npos) {
+    return parse_uint(s, ok) * price_scale(FIX_PRICE_DECIMALS);
+  }
+
+  uint64_t whole = parse_uint(s.substr(0, dot), ok);
+  std::string_view fraction = s.substr(dot + 1);
+  uint64_t fixed = 0;
+  bool bad = false;
+
+  for (size_t i = 0; i < FIX_PRICE_DECIMALS; ++i) {
+    uint32_t digit = i < fraction.size()
+                         ? static_cast<uint8_t>(fraction[i]) -
+                               static_cast<uint32_t>('0')
+                         : 0;
+    bad |= digit > 9;
+    fixed = fixed * 10 + digit;
+  }
+  for (size_t i = FIX_PRICE_DECIMALS; i < fraction.size(); ++i) {
+    bad |= fraction[i] != '0';
+  }
+
+  ok &= !bad;
+  return whole * price_scale(FIX_PRICE_DECIMALS) + fixed;
+}
+
+// Single-character enumerations: 54 Side, 40 OrdType
+char single_char(std::string_view s, bool &ok) {
+  ok &= s.size() == 1;
+  return s.empty() ? '\0' : s[0];
+}
+
+enum FieldBit : uint32_t {
+  CL_ORD_ID = 1 << 0,
+  ORIG_CL_ORD_ID = 1 << 1,
+  SYMBOL = 1 << 2,
+  SIDE = 1 << 3,
+  PRICE = 1 << 4,
+  ORDER_QTY = 1 << 5,
+  ORD_TYPE = 1 << 6
+};
+
+uint32_t required_fields(const FixOrder &order) {
+  uint32_t price = order.ord_type == OrderType::Limit ? uint32_t{PRICE} : 0;
+  switch (order.type) {
+  case FixMsgType::NewOrderSingle:
+    return CL_ORD_ID | SYMBOL | SIDE | ORDER_QTY | ORD_TYPE | price;
+  case FixMsgType::OrderCancelRequest:
+    return CL_ORD_ID | ORIG_CL_ORD_ID | SYMBOL | SIDE;
+  case FixMsgType::OrderCancelReplaceRequest:
+    return CL_ORD_ID | ORIG_CL_ORD_ID | SYMBOL | SIDE | ORDER_QTY |
+           ORD_TYPE | price;
+  default:
+    return 0;
+  }
+}
+
+} // namespace
+
+FixStatus decode_fix(const char *data, size_t len, FixOrder &order,
+                     size_t &consumed) {
+  static const ScanFn scan = select_scan();
+
+  consumed = 0;
+  order = FixOrder();
+
+  const size_t limit = std::min(len, FIX_MAX_MESSAGE);
+  size_t field = 0;               // Start of the current tag
+  size_t equals = NO_POSITION;    // '=' of the current field, once seen
+  size_t index = 0;               // Fields completed so far
+  size_t body_start = 0;          // First byte counted by BodyLength(9)
+  uint64_t body_length = 0;
+  uint32_t seen = 0;
+  bool ok = true;
+  char padded[64];
+
+  for (size_t block = 0; block < limit; block += 64) {
+    const char *p = data + block;
+    if (limit - block < 64) {
+      // Never load past the caller's buffer
+      std::memset(padded, 0, sizeof(padded));
+      std::memcpy(padded, p, limit - block);
+      p = padded;
+    }
+
+    DelimiterMasks masks = scan(p);
+    uint64_t bits = masks.soh | masks.equals;
+
+    while (bits) {
+      unsigned bit = static_cast<unsigned>(__builtin_ctzll(bits));
+      bits &= bits - 1;
+      size_t pos = block + bit;
+      bool is_soh = (masks.soh >> bit) & 1;
+
+      if (equals == NO_POSITION) {
+        if (is_soh) {
+          // Field without '='
+          ok = false;
+          field = pos + 1;
+          ++index;
+        } else {
+          equals = pos;
+        }
+        continue;
+      }
+      if (!is_soh) {
+        continue; // '=' inside a value
+      }
+
+      uint64_t tag = parse_uint({data + field, equals - field}, ok);
+      std::string_view value(data + equals + 1, pos - equals - 1);
+
+      // Standard header order: BeginString, BodyLength, MsgType
+      ok &= (index == 0) == (tag == 8);
+      ok &= (index == 1) == (tag == 9);
+      ok &= (index == 2) == (tag == 35);
+
+      switch (tag) {
+      case 9:
+        body_length = parse_uint(value, ok);
+        body_start = pos + 1;
+        break;
+      case 35:
+        // Multi-character types are valid, just not order messages
+        switch (value.size() == 1 ? value[0] : '\0') {
+        case 'D':
+          order.type = FixMsgType::NewOrderSingle;
+          break;
+        case 'F':
+          order.type = FixMsgType::OrderCancelRequest;
+          break;
+        case 'G':
+          order.type = FixMsgType::OrderCancelReplaceRequest;
+          break;
+        default:
+          order.type = FixMsgType::Other;
+          break;
+        }
+        break;
+      case 11:
+        order.cl_ord_id = parse_uint(value, ok);
+        seen |= CL_ORD_ID;
+        break;
+      case 41:
+        order.orig_cl_ord_id = parse_uint(value, ok);
+        seen |= ORIG_CL_ORD_ID;
+        break;
+      case 55:
+        order.symbol = value;
+        ok &= !value.empty();
+        seen |= SYMBOL;
+        break;
+      case 54: {
+        char side = single_char(value, ok);
+        ok &= side == '1' || side == '2';
+        order.side = side == '2' ? Side::Sell : Side::Buy;
+        seen |= SIDE;
+        break;
+      }
+      case 44:
+        order.price = parse_price(value, ok);
+        seen |= PRICE;
+        break;
+      case 38: {
+        uint64_t quantity = parse_uint(value, ok);
+        ok &= quantity <= UINT32_MAX;
+        order.quantity = static_cast<uint32_t>(quantity);
+        seen |= ORDER_QTY;
+        break;
+      }
+      case 40: {
+        char type = single_char(value, ok);
+        ok &= type == '1' || type == '2';
+        order.ord_type = type == '1' ? OrderType::Market : OrderType::Limit;
+        seen |= ORD_TYPE;
+        break;
+      }
+      case 10: {
+        consumed = pos + 1;
+        bool checksum_ok = value.size() == 3;
+        uint64_t checksum = parse_uint(value, checksum_ok);
+
+        if (!ok || index < 3) {
+          return FixStatus::Malformed;
+        }
+        if (!checksum_ok || body_length != field - body_start ||
+            checksum != byte_sum(data, field) % 256) {
+          return FixStatus::BadChecksum;
+        }
+        if (order.type == FixMsgType::Other) {
+          return FixStatus::Unsupported;
+        }
+        uint32_t required = required_fields(order);
+        return (seen & required) == required ? FixStatus::Ok
+                                             : FixStatus::Malformed;
+      }
+      default:
+        break; // Not needed by the engine
+      }
+
+      field = pos + 1;
+      equals = NO_POSITION;
+      ++index;
+    }
+  }
+
+  if (len >= FIX_MAX_MESSAGE) {
+    // No CheckSum within the size limit: not a message we can frame
+    consumed = FIX_MAX_MESSAGE;
+    return FixStatus::Malformed;
+  }
+  return FixStatus::Incomplete;
+}
+
+} // namespace hft
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "enums.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace hft {
+
+constexpr char FIX_SOH = '\x01';
+constexpr size_t FIX_MAX_MESSAGE = 4096;
+constexpr uint32_t FIX_PRICE_DECIMALS = 2; // Engine prices are in cents
+
+enum class FixMsgType : uint8_t {
+  NewOrderSingle = 0,            // 35=D
+  OrderCancelRequest = 1,        // 35=F
+  OrderCancelReplaceRequest = 2, // 35=G
+  Other = 3
+};
+
+enum class FixStatus : uint8_t {
+  Ok = 0,
+  Incomplete = 1,  // Need more bytes; nothing consumed
+  Malformed = 2,   // Bad framing, missing or unparsable field
+  BadChecksum = 3, // CheckSum(10) or BodyLength(9) do not match
+  Unsupported = 4  // Well-formed, but not an order message we handle
+};
+
+// Fields the engine needs from an order message. symbol points into the
+// decoded buffer.
+struct FixOrder {
+  FixMsgType type = FixMsgType::Other;
+  uint64_t cl_ord_id = 0;      // 11, must be numeric (it is the engine id)
+  uint64_t orig_cl_ord_id = 0; // 41, cancel and cancel/replace only
+  std::string_view symbol;     // 55
+  Side side = Side::Buy;       // 54
+  OrderType ord_type = OrderType::Limit; // 40
+  uint64_t price = 0;          // 44, in 1/10^FIX_PRICE_DECIMALS units
+  uint32_t quantity = 0;       // 38
+};
+
+// Decode the FIX 4.4 tag=value message at the start of data.
+//
+// SOH and '=' delimiters are located 64 bytes at a time with AVX2 (SSE2 if
+// the CPU lacks it); only the tags above are converted, everything else is
+// skipped. BodyLength and CheckSum are always validated. consumed is set to
+// the full message length for every status except Incomplete, so a stream
+// can step over bad messages.
+FixStatus decode_fix(const char *data, size_t len, FixOrder &order,
+                     size_t &consumed);
+
+} // namespace hft
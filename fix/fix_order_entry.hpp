@@ -0,0 +1,144 @@
+#pragma once
+
+#include "fix/fix_decoder.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace hft {
+
+// Decodes a FIX byte stream and hands each order message straight to a
+// BasicOrderBookManager. ClOrdID is used as the engine order id;
+// CancelReplace is applied as a cancel of OrigClOrdID followed by a new
+// order under ClOrdID, so the replacement joins the back of the queue.
+// As in FIX, a replace's OrderQty is the new total: the replacement rests
+// for OrderQty minus what the original chain has already executed, and the
+// replace is rejected (ReplaceBelowFilled) when nothing would be left.
+template <typename Manager>
+class FixOrderEntry {
+private:
+  using Book = typename Manager::Book;
+
+  // OrderQty as entered for a limit order placed through this session
+  struct Entered {
+    Book *book;
+    uint32_t quantity;
+  };
+
+  Manager &manager_;
+  uint32_t account_;
+  uint32_t sequence_ = 0;
+  std::string symbol_; // Reused so short symbols never allocate
+  std::unordered_map<uint64_t, Entered> entered_;
+  size_t sweep_at_ = 1024; // entered_ size that triggers dropping done orders
+
+  uint64_t messages_ = 0;
+  uint64_t invalid_messages_ = 0;
+  uint64_t rejected_orders_ = 0;
+
+public:
+  explicit FixOrderEntry(Manager &manager, uint32_t account = 0)
+      : manager_(manager), account_(account) {}
+
+  // Apply every complete message in data; returns the bytes consumed; the
+  // caller keeps the rest and presents it again with the next read
+  size_t on_data(const char *data, size_t len) {
+    size_t offset = 0;
+    while (offset < len) {
+      FixOrder order;
+      size_t consumed = 0;
+      FixStatus status = decode_fix(data + offset, len - offset, order, consumed);
+      if (status == FixStatus::Incomplete) {
+        break;
+      }
+
+      offset += consumed;
+      ++messages_;
+      if (status == FixStatus::Ok) {
+        submit(order);
+      } else if (status != FixStatus::Unsupported) {
+        ++invalid_messages_;
+      }
+    }
+    return offset;
+  }
+
+  // Apply one decoded message; false if the engine rejected it
+  bool submit(const FixOrder &order) {
+    symbol_.assign(order.symbol.data(), order.symbol.size());
+    uint32_t timestamp = ++sequence_;
+    uint32_t leaves = order.quantity;
+    bool ok = true;
+
+    if (order.type == FixMsgType::OrderCancelReplaceRequest) {
+      ok = replace_leaves(order, leaves);
+    }
+    if (ok && order.type != FixMsgType::NewOrderSingle) {
+      ok = manager_.process_order(symbol_, order.orig_cl_ord_id, 0, 0,
+                                  timestamp, OrderType::Cancel, order.side,
+                                  account_);
+      if (ok) {
+        entered_.erase(order.orig_cl_ord_id);
+      }
+    }
+    if (ok && order.type != FixMsgType::OrderCancelRequest) {
+      ok = manager_.process_order(symbol_, order.cl_ord_id, order.price,
+                                  leaves, timestamp, order.ord_type,
+                                  order.side, account_);
+      if (ok && order.ord_type == OrderType::Limit) {
+        track(order.cl_ord_id, order.quantity);
+      }
+    }
+
+    rejected_orders_ += !ok;
+    return ok;
+  }
+
+private:
+  // Quantity the replacement rests for: its OrderQty less what the original
+  // executed. An original that is not resting is left to the cancel to
+  // reject; one not entered here counts as unfilled.
+  bool replace_leaves(const FixOrder &order, uint32_t &leaves) {
+    auto it = entered_.find(order.orig_cl_ord_id);
+    if (it == entered_.end()) {
+      return true;
+    }
+
+    uint32_t open = it->second.book->get_order_quantity(order.orig_cl_ord_id);
+    if (open == 0) {
+      return true;
+    }
+
+    uint32_t executed = it->second.quantity - open;
+    if (order.quantity <= executed) {
+      manager_.listener().on_reject(order.cl_ord_id,
+                                    RejectReason::ReplaceBelowFilled);
+      return false;
+    }
+    leaves = order.quantity - executed;
+    return true;
+  }
+
+  void track(uint64_t cl_ord_id, uint32_t quantity) {
+    if (entered_.size() >= sweep_at_) {
+      // Forget orders that have filled completely since they were entered
+      for (auto it = entered_.begin(); it != entered_.end();) {
+        if (it->second.book->get_order_quantity(it->first) == 0) {
+          it = entered_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      sweep_at_ = std::max<size_t>(1024, 2 * entered_.size());
+    }
+    entered_[cl_ord_id] = {manager_.get_order_book(symbol_), quantity};
+  }
+
+public:
+  uint64_t messages() const { return messages_; }
+  uint64_t invalid_messages() const { return invalid_messages_; }
+  uint64_t rejected_orders() const { return rejected_orders_; }
+};
+
+} // namespace hft
@@ -0,0 +1,68 @@
+#include "gateway/order_gateway.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+hft::OrderGateway *g_gateway = nullptr;
+
+void handle_signal(int) {
+  if (g_gateway) {
+    g_gateway->stop();
+  }
+}
+
+void usage(const char *argv0) {
+  std::cerr << "Usage: " << argv0 << " [--unix PATH] [--tcp PORT] [--no-unix]\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  hft::GatewayConfig config;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--unix") == 0 && i + 1 < argc) {
+      config.unix_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--no-unix") == 0) {
+      config.unix_path.clear();
+    } else if (std::strcmp(argv[i], "--tcp") == 0 && i + 1 < argc) {
+      config.tcp_port = static_cast<uint16_t>(std::atoi(argv[++i]));
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  // Large object (per-session buffers), keep it off the stack
+  auto gateway = std::make_unique<hft::OrderGateway>(config);
+  if (!gateway->start()) {
+    std::cerr << "Failed to open gateway listeners: " << std::strerror(errno)
+              << "\n";
+    return 1;
+  }
+
+  g_gateway = gateway.get();
+  std::signal(SIGINT, handle_signal);
+  std::signal(SIGTERM, handle_signal);
+
+  std::cout << "Gateway listening";
+  if (!config.unix_path.empty()) {
+    std::cout << " on " << config.unix_path;
+  }
+  if (config.tcp_port != 0) {
+    std::cout << " on 127.0.0.1:" << config.tcp_port;
+  }
+  std::cout << std::endl;
+
+  gateway->run();
+
+  std::cout << "Processed " << gateway->messages_processed() << " messages, "
+            << gateway->backlogged_responses() << " responses backlogged\n";
+  g_gateway = nullptr;
+  return 0;
+}
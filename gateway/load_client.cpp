@@ -0,0 +1,301 @@
+#include "gateway/order_protocol.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Load generator for OrderGateway: opens many sessions, keeps a window of
+// requests in flight on each, and reports round-trip latency percentiles.
+// Every request gets exactly one reply carrying its client timestamp; fills
+// of resting orders arrive with a zero timestamp and are only counted.
+
+namespace {
+
+struct Options {
+  std::string unix_path = "/tmp/hft_gateway.sock";
+  uint16_t tcp_port = 0;
+  size_t sessions = 64;
+  size_t threads = 4;
+  size_t requests = 20000; // Per session
+  size_t window = 8;       // In-flight requests per session
+};
+
+struct Session {
+  int fd = -1;
+  bool buy = true;
+  size_t sent = 0;
+  size_t replies = 0;
+  size_t in_len = 0;
+  char in[64 * sizeof(hft::ResponseMessage)];
+};
+
+struct ThreadResult {
+  std::vector<uint64_t> latencies;
+  uint64_t fills = 0;
+  uint64_t rejects = 0;
+};
+
+uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int connect_gateway(const Options &opts) {
+  int fd;
+  if (opts.tcp_port != 0) {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(opts.tcp_port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 ||
+        connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+      return -1;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  } else {
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, opts.unix_path.c_str(),
+                 sizeof(addr.sun_path) - 1);
+    if (fd < 0 ||
+        connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+      return -1;
+    }
+  }
+  return fd;
+}
+
+// Request k of a session: even k places order n = k / 2, odd k cancels the
+// order placed RESTING_ORDERS earlier, so each session keeps a few orders on
+// the book. Every 16th order is a small market order that trades against the
+// other side.
+constexpr size_t RESTING_ORDERS = 4;
+
+hft::OrderMessage make_request(const Session &s, size_t k) {
+  hft::OrderMessage msg{};
+  size_t n = k / 2;
+  msg.client_order_id = n + 1;
+  msg.side = s.buy ? hft::Side::Buy : hft::Side::Sell;
+  msg.client_timestamp = now_ns();
+  std::memcpy(msg.symbol, "AAPL", 4);
+
+  if (k % 2 == 1) {
+    msg.type = hft::MessageType::CancelOrder;
+    if (n >= RESTING_ORDERS) {
+      msg.client_order_id = n + 1 - RESTING_ORDERS;
+    }
+    return msg;
+  }
+
+  msg.type = hft::MessageType::NewOrder;
+  if (n % 16 == 15) {
+    msg.order_type = hft::OrderType::Market;
+    msg.quantity = 1;
+  } else {
+    msg.order_type = hft::OrderType::Limit;
+    msg.quantity = 10;
+    uint64_t offset = 1 + n % 64;
+    msg.price = s.buy ? 100'00 - offset : 100'00 + offset;
+  }
+  return msg;
+}
+
+void top_up(Session &s, const Options &opts) {
+  hft::OrderMessage batch[64];
+  size_t count = 0;
+
+  while (s.sent < opts.requests && s.sent - s.replies < opts.window &&
+         count < 64) {
+    batch[count++] = make_request(s, s.sent++);
+  }
+
+  // Blocking socket; the window keeps this far below the socket buffer
+  const char *data = reinterpret_cast<const char *>(batch);
+  size_t len = count * sizeof(hft::OrderMessage);
+  while (len > 0) {
+    ssize_t n = send(s.fd, data, len, MSG_NOSIGNAL);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data += n;
+    len -= static_cast<size_t>(n);
+  }
+}
+
+void run_thread(const Options &opts, size_t first, size_t count,
+                ThreadResult &result, std::atomic<bool> &failed) {
+  std::vector<Session> sessions(count);
+  int epoll_fd = epoll_create1(0);
+
+  for (size_t i = 0; i < count; ++i) {
+    sessions[i].fd = connect_gateway(opts);
+    sessions[i].buy = (first + i) % 2 == 0;
+    if (sessions[i].fd < 0) {
+      failed = true;
+      return;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = i;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sessions[i].fd, &ev);
+    top_up(sessions[i], opts);
+  }
+
+  result.latencies.reserve(count * opts.requests);
+  size_t done = 0;
+  epoll_event events[64];
+
+  while (done < count) {
+    int n = epoll_wait(epoll_fd, events, 64, 1000);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      failed = true; // Gateway stalled or went away
+      break;
+    }
+
+    for (int e = 0; e < n; ++e) {
+      Session &s = sessions[events[e].data.u64];
+      ssize_t r = read(s.fd, s.in + s.in_len, sizeof(s.in) - s.in_len);
+      if (r <= 0) {
+        failed = true;
+        done = count;
+        break;
+      }
+      s.in_len += static_cast<size_t>(r);
+
+      uint64_t now = now_ns();
+      size_t offset = 0;
+      while (s.in_len - offset >= sizeof(hft::ResponseMessage)) {
+        hft::ResponseMessage resp;
+        std::memcpy(&resp, s.in + offset, sizeof(resp));
+        offset += sizeof(resp);
+
+        if (resp.type == hft::ResponseType::Fill) {
+          ++result.fills;
+        } else if (resp.type == hft::ResponseType::Reject) {
+          ++result.rejects;
+        }
+        if (resp.client_timestamp != 0) {
+          result.latencies.push_back(now - resp.client_timestamp);
+          if (++s.replies == opts.requests) {
+            ++done;
+          }
+        }
+      }
+      std::memmove(s.in, s.in + offset, s.in_len - offset);
+      s.in_len -= offset;
+
+      top_up(s, opts);
+    }
+  }
+
+  for (auto &s : sessions) {
+    close(s.fd);
+  }
+  close(epoll_fd);
+}
+
+uint64_t percentile(const std::vector<uint64_t> &sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+  return sorted[index];
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    const char *value = argv[i + 1];
+    if (flag == "--unix") {
+      opts.unix_path = value;
+    } else if (flag == "--tcp") {
+      opts.tcp_port = static_cast<uint16_t>(std::atoi(value));
+    } else if (flag == "--sessions") {
+      opts.sessions = std::strtoul(value, nullptr, 10);
+    } else if (flag == "--threads") {
+      opts.threads = std::strtoul(value, nullptr, 10);
+    } else if (flag == "--requests") {
+      opts.requests = std::strtoul(value, nullptr, 10);
+    } else if (flag == "--window") {
+      opts.window = std::min<size_t>(std::strtoul(value, nullptr, 10), 64);
+    } else {
+      std::cerr << "Unknown option " << flag << "\n";
+      return 1;
+    }
+  }
+  opts.threads = std::max<size_t>(1, std::min(opts.threads, opts.sessions));
+
+  std::vector<ThreadResult> results(opts.threads);
+  std::vector<std::thread> threads;
+  std::atomic<bool> failed{false};
+
+  uint64_t start = now_ns();
+  size_t first = 0;
+  for (size_t t = 0; t < opts.threads; ++t) {
+    size_t count = opts.sessions / opts.threads +
+                   (t < opts.sessions % opts.threads ? 1 : 0);
+    threads.emplace_back(run_thread, std::cref(opts), first, count,
+                         std::ref(results[t]), std::ref(failed));
+    first += count;
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  uint64_t elapsed = now_ns() - start;
+
+  std::vector<uint64_t> latencies;
+  uint64_t fills = 0;
+  uint64_t rejects = 0;
+  for (auto &r : results) {
+    latencies.insert(latencies.end(), r.latencies.begin(), r.latencies.end());
+    fills += r.fills;
+    rejects += r.rejects;
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  if (failed) {
+    std::cerr << "Run incomplete: connection failed or gateway stalled\n";
+  }
+
+  std::cout << "Sessions: " << opts.sessions << " | Threads: " << opts.threads
+            << " | Window: " << opts.window << "\n";
+  std::cout << "Replies: " << latencies.size() << " | Fills: " << fills
+            << " | Rejects: " << rejects << "\n";
+  std::cout << "Throughput: "
+            << (elapsed ? latencies.size() * 1'000'000'000ull / elapsed : 0)
+            << " msg/s\n";
+  std::cout << "RTT ns  p50: " << percentile(latencies, 0.50)
+            << "  p90: " << percentile(latencies, 0.90)
+            << "  p99: " << percentile(latencies, 0.99)
+            << "  p99.9: " << percentile(latencies, 0.999)
+            << "  max: " << (latencies.empty() ? 0 : latencies.back()) << "\n";
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,512 @@
+#include "gateway/order_gateway.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace hft {
+
+namespace {
+
+constexpr uint64_t CLIENT_ID_MASK = (uint64_t{1} << 48) - 1;
+
+// epoll user data for the non-session descriptors
+constexpr uint64_t UNIX_LISTENER_TAG = ~uint64_t{0};
+constexpr uint64_t TCP_LISTENER_TAG = ~uint64_t{0} - 1;
+constexpr uint64_t WAKE_TAG = ~uint64_t{0} - 2;
+
+// Keep room for what a single message usually produces for its sender
+// (reply + own fill) before pulling another message off the input buffer;
+// an order sweeping several levels spills into the session backlog
+constexpr size_t RESPONSE_RESERVE = 4 * sizeof(ResponseMessage);
+
+uint64_t make_engine_id(size_t slot, uint8_t generation, uint64_t client_id) {
+  return (static_cast<uint64_t>(slot) << 56) |
+         (static_cast<uint64_t>(generation) << 48) |
+         (client_id & CLIENT_ID_MASK);
+}
+
+int open_unix_listener(const std::string &path) {
+  sockaddr_un addr{};
+  if (path.size() >= sizeof(addr.sun_path)) {
+    return -1;
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return -1;
+  }
+
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  unlink(path.c_str());
+
+  if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      listen(fd, SOMAXCONN) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+int open_tcp_listener(uint16_t port) {
+  int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return -1;
+  }
+
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      listen(fd, SOMAXCONN) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+bool watch(int epoll_fd, int fd, uint32_t events, uint64_t tag) {
+  epoll_event ev{};
+  ev.events = events;
+  ev.data.u64 = tag;
+  return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0;
+}
+
+} // namespace
+
+OrderGateway::OrderGateway(GatewayConfig config)
+    : config_(std::move(config)), manager_(GatewayListener{{}, this}),
+      sessions_(MAX_GATEWAY_SESSIONS) {
+  dirty_sessions_.reserve(MAX_GATEWAY_SESSIONS);
+  free_slots_.reserve(MAX_GATEWAY_SESSIONS);
+  closed_slots_.reserve(MAX_GATEWAY_SESSIONS);
+  for (size_t i = MAX_GATEWAY_SESSIONS; i > 0; --i) {
+    free_slots_.push_back(i - 1);
+  }
+}
+
+OrderGateway::~OrderGateway() {
+  for (size_t slot = 0; slot < sessions_.size(); ++slot) {
+    if (sessions_[slot].fd >= 0) {
+      close(sessions_[slot].fd);
+    }
+  }
+
+  for (int fd : {unix_fd_, tcp_fd_, wake_fd_, epoll_fd_}) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  if (unix_fd_ >= 0) {
+    unlink(config_.unix_path.c_str());
+  }
+}
+
+bool OrderGateway::start() {
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epoll_fd_ < 0 || wake_fd_ < 0 ||
+      !watch(epoll_fd_, wake_fd_, EPOLLIN, WAKE_TAG)) {
+    return false;
+  }
+
+  if (!config_.unix_path.empty()) {
+    unix_fd_ = open_unix_listener(config_.unix_path);
+    if (unix_fd_ < 0 ||
+        !watch(epoll_fd_, unix_fd_, EPOLLIN | EPOLLET, UNIX_LISTENER_TAG)) {
+      return false;
+    }
+  }
+
+  if (config_.tcp_port != 0) {
+    tcp_fd_ = open_tcp_listener(config_.tcp_port);
+    if (tcp_fd_ < 0 ||
+        !watch(epoll_fd_, tcp_fd_, EPOLLIN | EPOLLET, TCP_LISTENER_TAG)) {
+      return false;
+    }
+  }
+
+  running_ = unix_fd_ >= 0 || tcp_fd_ >= 0;
+  return running_;
+}
+
+void OrderGateway::run() {
+  std::array<epoll_event, GATEWAY_MAX_EVENTS> events;
+
+  while (running_) {
+    int n = epoll_wait(epoll_fd_, events.data(), events.size(), -1);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+
+    for (int i = 0; i < n; ++i) {
+      uint64_t tag = events[i].data.u64;
+      uint32_t mask = events[i].events;
+
+      if (tag == UNIX_LISTENER_TAG) {
+        accept_all(unix_fd_);
+      } else if (tag == TCP_LISTENER_TAG) {
+        accept_all(tcp_fd_);
+      } else if (tag == WAKE_TAG) {
+        uint64_t value;
+        [[maybe_unused]] ssize_t r = read(wake_fd_, &value, sizeof(value));
+      } else {
+        size_t slot = static_cast<size_t>(tag);
+        if (sessions_[slot].fd < 0) {
+          continue; // Closed earlier in this batch
+        }
+        if (mask & (EPOLLERR | EPOLLHUP)) {
+          close_session(slot);
+          continue;
+        }
+        if ((mask & EPOLLOUT) && flush(slot) && sessions_[slot].blocked) {
+          sessions_[slot].blocked = false;
+        }
+        if (mask & (EPOLLIN | EPOLLRDHUP | EPOLLOUT)) {
+          on_readable(slot);
+        }
+      }
+    }
+
+    // One write per session per loop iteration
+    flush_dirty();
+    release_closed();
+  }
+}
+
+void OrderGateway::stop() {
+  running_ = false;
+  uint64_t one = 1;
+  [[maybe_unused]] ssize_t r = write(wake_fd_, &one, sizeof(one));
+}
+
+void OrderGateway::accept_all(int listen_fd) {
+  while (true) {
+    int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return; // EAGAIN: backlog drained
+    }
+
+    if (free_slots_.empty()) {
+      close(fd);
+      continue;
+    }
+
+    if (listen_fd == tcp_fd_) {
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+
+    size_t slot = free_slots_.back();
+    free_slots_.pop_back();
+
+    Session &s = sessions_[slot];
+    s.fd = fd;
+    s.generation = static_cast<uint8_t>(s.generation + 1);
+    s.dirty = false;
+    s.blocked = false;
+    s.in_len = s.out_len = s.out_sent = 0;
+
+    if (!watch(epoll_fd_, fd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET,
+               slot)) {
+      close_session(slot);
+    }
+  }
+}
+
+void OrderGateway::close_session(size_t slot) {
+  Session &s = sessions_[slot];
+  if (s.fd < 0) {
+    return;
+  }
+
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, s.fd, nullptr);
+  close(s.fd);
+  s.fd = -1;
+  s.in_len = s.out_len = s.out_sent = 0;
+  std::vector<char>().swap(s.backlog); // Release a slow client's backlog
+  s.backlog_sent = 0;
+
+  // May be running inside a book callback (a fill whose flush failed), so
+  // the resting orders are cancelled later by release_closed()
+  closed_slots_.push_back(slot);
+}
+
+void OrderGateway::release_closed() {
+  for (size_t slot : closed_slots_) {
+    Session &s = sessions_[slot];
+    for (const auto &[engine_id, book] : s.resting) {
+      book->cancel_order(engine_id);
+    }
+    s.resting.clear();
+    free_slots_.push_back(slot);
+  }
+  closed_slots_.clear();
+}
+
+void OrderGateway::on_readable(size_t slot) {
+  Session &s = sessions_[slot];
+
+  // Edge-triggered: keep reading until the socket reports EAGAIN
+  while (s.fd >= 0) {
+    process_input(slot);
+    if (s.blocked || s.fd < 0) {
+      return;
+    }
+
+    ssize_t n = read(s.fd, s.in.data() + s.in_len, s.in.size() - s.in_len);
+    if (n > 0) {
+      s.in_len += static_cast<size_t>(n);
+    } else if (n == 0) {
+      close_session(slot);
+      return;
+    } else if (errno == EINTR) {
+      continue;
+    } else {
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        close_session(slot);
+      }
+      return;
+    }
+  }
+}
+
+void OrderGateway::process_input(size_t slot) {
+  Session &s = sessions_[slot];
+  size_t offset = 0;
+
+  while (s.in_len - offset >= sizeof(OrderMessage)) {
+    if ((s.out.size() - s.out_len < RESPONSE_RESERVE || !s.backlog.empty()) &&
+        !flush(slot)) {
+      s.blocked = s.fd >= 0;
+      break;
+    }
+
+    OrderMessage msg;
+    std::memcpy(&msg, s.in.data() + offset, sizeof(msg));
+    offset += sizeof(msg);
+    handle_message(slot, msg);
+  }
+
+  // Keep a trailing partial message for the next read
+  if (offset > 0 && s.fd >= 0) {
+    std::memmove(s.in.data(), s.in.data() + offset, s.in_len - offset);
+    s.in_len -= offset;
+  }
+}
+
+void OrderGateway::handle_message(size_t slot, const OrderMessage &msg) {
+  ++messages_;
+
+  ResponseMessage response{};
+  response.side = msg.side;
+  response.quantity = msg.quantity;
+  response.client_order_id = msg.client_order_id;
+  response.price = msg.price;
+  response.client_timestamp = msg.client_timestamp;
+
+  bool valid =
+      msg.client_order_id <= CLIENT_ID_MASK &&
+      (msg.type == MessageType::CancelOrder ||
+       (msg.type == MessageType::NewOrder &&
+        (msg.order_type == OrderType::Limit ||
+         msg.order_type == OrderType::Market) &&
+        (msg.side == Side::Buy || msg.side == Side::Sell)));
+  if (!valid) {
+    response.type = ResponseType::Reject;
+    response.reason = RejectReason::InvalidMessage;
+    push_response(slot, response);
+    return;
+  }
+
+  std::string symbol(msg.symbol, strnlen(msg.symbol, GATEWAY_SYMBOL_LENGTH));
+  uint64_t engine_id =
+      make_engine_id(slot, sessions_[slot].generation, msg.client_order_id);
+  OrderType type = msg.type == MessageType::CancelOrder ? OrderType::Cancel
+                                                        : msg.order_type;
+
+  last_reject_ = type == OrderType::Market ? RejectReason::NoLiquidity
+                                           : RejectReason::UnknownOrder;
+  aggressor_filled_ = 0;
+  aggressor_notional_ = 0;
+
+  bool ok = manager_.process_order(symbol, engine_id, msg.price, msg.quantity,
+                                   ++sequence_, type, msg.side,
+                                   static_cast<uint32_t>(slot));
+
+  switch (type) {
+  case OrderType::Limit:
+    response.type = ok ? ResponseType::Ack : ResponseType::Reject;
+    response.reason = last_reject_;
+    if (ok) {
+      // Ack first, then the fills of an order that crossed the spread
+      push_response(slot, response);
+      auto *book = manager_.get_order_book(symbol);
+      sessions_[slot].resting.emplace(engine_id, book);
+      if (book->get_best_bid() >= book->get_best_ask()) {
+        book->match_orders();
+      }
+      return;
+    }
+    break;
+
+  case OrderType::Market:
+    if (aggressor_filled_ > 0) {
+      response.type = ResponseType::Fill;
+      response.quantity = aggressor_filled_;
+      response.price = aggressor_notional_ / aggressor_filled_; // Average
+    } else {
+      response.type = ResponseType::Reject;
+      response.reason = last_reject_;
+    }
+    break;
+
+  case OrderType::Cancel:
+    if (ok) {
+      sessions_[slot].resting.erase(engine_id);
+    }
+    response.type = ok ? ResponseType::Cancelled : ResponseType::Reject;
+    response.reason = last_reject_;
+    break;
+  }
+
+  push_response(slot, response);
+}
+
+void OrderGateway::on_engine_fill(const Order &order, uint64_t price,
+                                  uint32_t quantity) {
+  size_t slot = static_cast<size_t>(order.id >> 56);
+  uint8_t generation = static_cast<uint8_t>(order.id >> 48);
+
+  if (sessions_[slot].generation != generation) {
+    return; // Stale id; cannot rest past release_closed()
+  }
+  if (order.quantity == 0) {
+    sessions_[slot].resting.erase(order.id); // No-op for market orders
+  }
+  if (sessions_[slot].fd < 0) {
+    return; // Owner disconnected, cancel pending
+  }
+
+  ResponseMessage response{};
+  response.type = ResponseType::Fill;
+  response.side = order.side;
+  response.quantity = quantity;
+  response.client_order_id = order.id & CLIENT_ID_MASK;
+  response.price = price;
+  push_response(slot, response);
+}
+
+bool OrderGateway::push_response(size_t slot, const ResponseMessage &response) {
+  Session &s = sessions_[slot];
+  if (s.fd < 0) {
+    return false;
+  }
+
+  if (s.backlog.empty() && s.out.size() - s.out_len < sizeof(response)) {
+    // Reclaim the already-sent prefix, then try to drain the rest
+    if (s.out_sent > 0) {
+      std::memmove(s.out.data(), s.out.data() + s.out_sent,
+                   s.out_len - s.out_sent);
+      s.out_len -= s.out_sent;
+      s.out_sent = 0;
+    }
+    if (s.out.size() - s.out_len < sizeof(response) && !flush(slot) &&
+        s.fd < 0) {
+      return false; // Connection failed while flushing
+    }
+  }
+
+  if (s.backlog.empty() && s.out.size() - s.out_len >= sizeof(response)) {
+    std::memcpy(s.out.data() + s.out_len, &response, sizeof(response));
+    s.out_len += sizeof(response);
+  } else {
+    // Client is not keeping up: queue behind the buffer, stop reading its
+    // orders until the backlog drains (see flush)
+    const char *bytes = reinterpret_cast<const char *>(&response);
+    s.backlog.insert(s.backlog.end(), bytes, bytes + sizeof(response));
+    s.blocked = true;
+    ++backlogged_responses_;
+  }
+
+  if (!s.dirty) {
+    s.dirty = true;
+    dirty_sessions_.push_back(slot);
+  }
+  return true;
+}
+
+bool OrderGateway::flush(size_t slot) {
+  Session &s = sessions_[slot];
+
+  while (s.fd >= 0) {
+    while (s.out_sent < s.out_len) {
+      ssize_t n = send(s.fd, s.out.data() + s.out_sent,
+                       s.out_len - s.out_sent, MSG_NOSIGNAL);
+      if (n > 0) {
+        s.out_sent += static_cast<size_t>(n);
+      } else if (n < 0 && errno == EINTR) {
+        continue;
+      } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return false; // EPOLLOUT will fire once there is room
+      } else {
+        close_session(slot);
+        return false;
+      }
+    }
+    s.out_len = s.out_sent = 0;
+
+    if (s.backlog.empty()) {
+      break;
+    }
+
+    // Refill the output buffer from the backlog
+    size_t n = std::min(s.backlog.size() - s.backlog_sent, s.out.size());
+    std::memcpy(s.out.data(), s.backlog.data() + s.backlog_sent, n);
+    s.out_len = n;
+    s.backlog_sent += n;
+    if (s.backlog_sent == s.backlog.size()) {
+      s.backlog.clear();
+      s.backlog_sent = 0;
+    }
+  }
+
+  return s.fd >= 0;
+}
+
+void OrderGateway::flush_dirty() {
+  // Sessions unblocked here may queue more output, so iterate by index
+  for (size_t i = 0; i < dirty_sessions_.size(); ++i) {
+    size_t slot = dirty_sessions_[i];
+    Session &s = sessions_[slot];
+    s.dirty = false;
+
+    if (flush(slot) && s.blocked) {
+      s.blocked = false;
+      on_readable(slot);
+    }
+  }
+  dirty_sessions_.clear();
+}
+
+} // namespace hft
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "gateway/order_protocol.hpp"
+#include "order_book_listener.hpp"
+#include "order_book_manager.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hft {
+
+constexpr size_t MAX_GATEWAY_SESSIONS = 256;
+constexpr size_t GATEWAY_BUFFER_SIZE = 16 * 1024;
+constexpr size_t GATEWAY_MAX_EVENTS = 64;
+
+class OrderGateway;
+
+// Engine listener that hands fills and rejects back to the gateway so they
+// can be routed to the owning session.
+struct GatewayListener : NullOrderBookListener {
+  OrderGateway *gateway = nullptr;
+
+  void on_reject(uint64_t order_id, RejectReason reason);
+  void on_fill(const Order &order, uint64_t price, uint32_t quantity);
+  void on_trade(std::string_view symbol, uint64_t price, uint32_t quantity,
+                Side aggressor);
+};
+
+struct GatewayConfig {
+  std::string unix_path = "/tmp/hft_gateway.sock"; // Empty = no UDS listener
+  uint16_t tcp_port = 0;                            // 0 = no TCP listener
+};
+
+// Local order-entry gateway in front of a BasicOrderBookManager.
+//
+// One thread runs an edge-triggered epoll loop: each readable session is
+// drained into its input buffer, every complete OrderMessage is handed to the
+// engine, and responses are appended to preallocated per-session output
+// buffers that are flushed once per loop iteration. Engine order ids carry
+// the session slot and generation above a 48-bit client order id, so fills
+// are routed back to a session without any lookup table. When a session
+// disconnects its resting orders are cancelled at the end of the loop
+// iteration (outside any book lock) and only then is the slot reused, so a
+// wrapped generation never matches a live order of an earlier connection.
+//
+// Responses are never dropped for a connected session: when its output
+// buffer is full (the client is not reading), further responses spill into
+// a growable per-session backlog and the gateway stops reading from that
+// session until EPOLLOUT has drained everything. A blocked session cannot
+// submit orders, so its backlog only grows by fills of its resting orders.
+class OrderGateway {
+private:
+  using Book = BasicOrderBookManager<GatewayListener>::Book;
+
+  struct Session {
+    int fd = -1;
+    uint8_t generation = 0; // Bumped on reuse so stale fills are dropped
+    bool dirty = false;   // Has unflushed output
+    bool blocked = false; // Input parked until output drains
+    size_t in_len = 0;
+    size_t out_len = 0;
+    size_t out_sent = 0;
+    size_t backlog_sent = 0; // Prefix of backlog already moved to out
+    std::array<char, GATEWAY_BUFFER_SIZE> in;
+    std::array<char, GATEWAY_BUFFER_SIZE> out;
+    std::vector<char> backlog; // Overflow of out, in response order
+    std::unordered_map<uint64_t, Book *> resting; // Live orders by engine id
+  };
+
+  GatewayConfig config_;
+  BasicOrderBookManager<GatewayListener> manager_;
+  std::vector<Session> sessions_;
+  std::vector<size_t> dirty_sessions_;
+  std::vector<size_t> free_slots_;
+  std::vector<size_t> closed_slots_; // Awaiting cancel of resting orders
+  int epoll_fd_ = -1;
+  int unix_fd_ = -1;
+  int tcp_fd_ = -1;
+  int wake_fd_ = -1;
+  std::atomic<bool> running_{false};
+  uint32_t sequence_ = 0;
+
+  // Engine feedback for the message being processed
+  RejectReason last_reject_ = RejectReason::UnknownOrder;
+  uint32_t aggressor_filled_ = 0;
+  uint64_t aggressor_notional_ = 0;
+
+  uint64_t messages_ = 0;
+  uint64_t backlogged_responses_ = 0;
+
+  // Internal methods
+  void accept_all(int listen_fd);
+  void close_session(size_t slot);
+  void release_closed();
+  void on_readable(size_t slot);
+  void process_input(size_t slot);
+  void handle_message(size_t slot, const OrderMessage &msg);
+  bool push_response(size_t slot, const ResponseMessage &response);
+  bool flush(size_t slot);
+  void flush_dirty();
+
+public:
+  explicit OrderGateway(GatewayConfig config = GatewayConfig());
+  ~OrderGateway();
+
+  OrderGateway(const OrderGateway &) = delete;
+  OrderGateway &operator=(const OrderGateway &) = delete;
+
+  // Bind the listeners; false if a socket could not be set up
+  bool start();
+
+  // Event loop; returns after stop() is called (from any thread)
+  void run();
+  void stop();
+
+  BasicOrderBookManager<GatewayListener> &manager() { return manager_; }
+
+  uint64_t messages_processed() const { return messages_; }
+  // Responses that did not fit a session's output buffer and were queued
+  uint64_t backlogged_responses() const { return backlogged_responses_; }
+
+  // Engine callbacks (see GatewayListener)
+  void on_engine_reject(RejectReason reason) { last_reject_ = reason; }
+  void on_engine_fill(const Order &order, uint64_t price, uint32_t quantity);
+  void on_engine_trade(uint64_t price, uint32_t quantity) {
+    aggressor_filled_ += quantity;
+    aggressor_notional_ += price * quantity;
+  }
+};
+
+inline void GatewayListener::on_reject(uint64_t /*order_id*/,
+                                       RejectReason reason) {
+  gateway->on_engine_reject(reason);
+}
+
+inline void GatewayListener::on_fill(const Order &order, uint64_t price,
+                                     uint32_t quantity) {
+  gateway->on_engine_fill(order, price, quantity);
+}
+
+inline void GatewayListener::on_trade(std::string_view /*symbol*/,
+                                      uint64_t price, uint32_t quantity,
+                                      Side /*aggressor*/) {
+  gateway->on_engine_trade(price, quantity);
+}
+
+} // namespace hft
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "enums.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace hft {
+
+// Binary order-entry protocol spoken by OrderGateway. Messages are fixed
+// size and sent in host byte order; the transport is local only (Unix domain
+// socket or loopback TCP), so no endian conversion is done.
+
+constexpr size_t GATEWAY_SYMBOL_LENGTH = 8;
+
+enum class MessageType : uint8_t {
+  NewOrder = 1,
+  CancelOrder = 2
+};
+
+enum class ResponseType : uint8_t {
+  Ack = 1,
+  Reject = 2,
+  Fill = 3,
+  Cancelled = 4
+};
+
+// Client -> gateway
+struct OrderMessage {
+  MessageType type;
+  OrderType order_type; // Limit or Market, ignored for cancels
+  Side side;            // Buy or Sell, ignored for cancels
+  uint8_t reserved;
+  uint32_t quantity;
+  uint64_t client_order_id; // Must fit in 48 bits, unique per session
+  uint64_t price;
+  uint64_t client_timestamp; // Echoed back in the response
+  char symbol[GATEWAY_SYMBOL_LENGTH]; // NUL padded
+};
+
+// Gateway -> client
+struct ResponseMessage {
+  ResponseType type;
+  RejectReason reason; // Only meaningful for Reject
+  Side side;
+  uint8_t reserved;
+  uint32_t quantity; // Filled quantity for Fill, order quantity otherwise
+  uint64_t client_order_id;
+  uint64_t price;
+  uint64_t client_timestamp; // 0 for fills of resting orders
+};
+
+static_assert(sizeof(OrderMessage) == 40, "OrderMessage must stay 40 bytes");
+static_assert(sizeof(ResponseMessage) == 32,
+              "ResponseMessage must stay 32 bytes");
+
+} // namespace hft
@@ -0,0 +1,112 @@
+#include "market_data/md_consumer.hpp"
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hft {
+
+MarketDataConsumer::~MarketDataConsumer() { close(); }
+
+bool MarketDataConsumer::open(const std::string &name, bool from_start) {
+  close();
+
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) < 0 ||
+      static_cast<size_t>(st.st_size) < sizeof(RingHeader)) {
+    ::close(fd);
+    return false;
+  }
+
+  size_t bytes = static_cast<size_t>(st.st_size);
+  void *addr = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+
+  auto *header = static_cast<const RingHeader *>(addr);
+  if (header->magic.load(std::memory_order_acquire) != MD_RING_MAGIC ||
+      header->version != MD_RING_VERSION || header->capacity == 0 ||
+      ring_bytes(header->capacity) > bytes) {
+    munmap(addr, bytes);
+    return false;
+  }
+
+  header_ = header;
+  slots_ = ring_slots(header_);
+  mapped_bytes_ = bytes;
+  capacity_ = header_->capacity;
+  mask_ = capacity_ - 1;
+  lost_ = 0;
+  overruns_ = 0;
+
+  uint64_t written = header_->write_sequence.load(std::memory_order_acquire);
+  if (from_start) {
+    next_ = written >= capacity_ ? written - capacity_ + 1 : 1;
+  } else {
+    next_ = written + 1;
+  }
+  return true;
+}
+
+void MarketDataConsumer::close() {
+  if (!header_) {
+    return;
+  }
+
+  munmap(const_cast<RingHeader *>(header_), mapped_bytes_);
+  header_ = nullptr;
+  slots_ = nullptr;
+  mapped_bytes_ = 0;
+}
+
+void MarketDataConsumer::resync() {
+  // Jump to the oldest update the producer has not overwritten yet. The
+  // slot for next_ is known to be gone, so always move past it.
+  uint64_t written = header_->write_sequence.load(std::memory_order_acquire);
+  uint64_t oldest = written >= capacity_ ? written - capacity_ + 1 : 1;
+  oldest = std::max(oldest, next_ + 1);
+
+  lost_ += oldest - next_;
+  next_ = oldest;
+  ++overruns_;
+}
+
+PollResult MarketDataConsumer::poll(MarketDataUpdate &update) {
+  if (!header_) {
+    return PollResult::Empty;
+  }
+
+  const RingSlot &slot = slots_[next_ & mask_];
+  uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+  if (sequence == next_) {
+    load_payload(slot, update);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // Still the same sequence: the copy is consistent
+    if (slot.sequence.load(std::memory_order_relaxed) == next_) {
+      ++next_;
+      return PollResult::Update;
+    }
+    resync();
+    return PollResult::Overrun;
+  }
+
+  // Either not published yet (or mid-write), or lapped by the producer
+  uint64_t written = header_->write_sequence.load(std::memory_order_acquire);
+  if (written >= next_ + capacity_) {
+    resync();
+    return PollResult::Overrun;
+  }
+  return PollResult::Empty;
+}
+
+} // namespace hft
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "market_data/shm_ring.hpp"
+#include <cstdint>
+#include <string>
+
+namespace hft {
+
+enum class PollResult : uint8_t {
+  Update = 0,  // An update was copied out
+  Empty = 1,   // Nothing new yet
+  Overrun = 2  // The producer lapped us; skipped ahead, see lost_updates()
+};
+
+// Read-only view of a market-data ring published by another process. Each
+// consumer keeps its own position, so consumers never slow the producer or
+// each other.
+class MarketDataConsumer {
+private:
+  const RingHeader *header_ = nullptr;
+  const RingSlot *slots_ = nullptr;
+  size_t mapped_bytes_ = 0;
+  uint64_t mask_ = 0;
+  uint64_t capacity_ = 0;
+  uint64_t next_ = 1; // Next sequence to read
+  uint64_t lost_ = 0;
+  uint64_t overruns_ = 0;
+
+  void resync();
+
+public:
+  MarketDataConsumer() = default;
+  ~MarketDataConsumer();
+
+  MarketDataConsumer(const MarketDataConsumer &) = delete;
+  MarketDataConsumer &operator=(const MarketDataConsumer &) = delete;
+
+  // Attach to an existing ring. from_start replays whatever is still in the
+  // ring; otherwise only updates published after attaching are seen.
+  bool open(const std::string &name, bool from_start = false);
+  void close();
+
+  PollResult poll(MarketDataUpdate &update);
+
+  uint64_t next_sequence() const { return next_; }
+  uint64_t lost_updates() const { return lost_; }
+  uint64_t overruns() const { return overruns_; }
+};
+
+} // namespace hft
@@ -0,0 +1,149 @@
+#include "market_data/md_publisher.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace hft {
+
+namespace {
+
+uint64_t steady_now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void copy_symbol(char (&dst)[MD_SYMBOL_LENGTH], std::string_view symbol) {
+  std::memset(dst, 0, MD_SYMBOL_LENGTH);
+  std::memcpy(dst, symbol.data(), std::min(symbol.size(), MD_SYMBOL_LENGTH));
+}
+
+} // namespace
+
+MarketDataPublisher::~MarketDataPublisher() { close(); }
+
+bool MarketDataPublisher::open(const std::string &name, uint32_t capacity) {
+  close();
+
+  uint32_t slots = 1;
+  while (slots < capacity) {
+    slots <<= 1;
+  }
+
+  // Start from a fresh segment so stale consumers cannot misread it
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    return false;
+  }
+
+  size_t bytes = ring_bytes(slots);
+  if (ftruncate(fd, static_cast<off_t>(bytes)) < 0) {
+    ::close(fd);
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  void *addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (addr == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  // ftruncate zero-fills, which is a valid empty ring; publish the header last
+  name_ = name;
+  header_ = static_cast<RingHeader *>(addr);
+  slots_ = ring_slots(header_);
+  mapped_bytes_ = bytes;
+  mask_ = slots - 1;
+  sequence_ = 0;
+#ifndef NDEBUG
+  owner_ = std::thread::id();
+#endif
+
+  header_->version = MD_RING_VERSION;
+  header_->capacity = slots;
+  header_->write_sequence.store(0, std::memory_order_relaxed);
+  header_->magic.store(MD_RING_MAGIC, std::memory_order_release);
+  return true;
+}
+
+void MarketDataPublisher::close() {
+  if (!header_) {
+    return;
+  }
+
+  munmap(header_, mapped_bytes_);
+  shm_unlink(name_.c_str());
+  header_ = nullptr;
+  slots_ = nullptr;
+  mapped_bytes_ = 0;
+}
+
+void MarketDataPublisher::publish(const MarketDataUpdate &update) {
+#ifndef NDEBUG
+  if (owner_ == std::thread::id()) {
+    owner_ = std::this_thread::get_id();
+  }
+  assert(owner_ == std::this_thread::get_id() &&
+         "MarketDataPublisher has a single producer thread");
+#endif
+
+  uint64_t sequence = ++sequence_;
+  RingSlot &slot = slots_[sequence & mask_];
+
+  // Seqlock write: invalidate, fill, then stamp with the new sequence
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  store_payload(slot, update);
+  slot.sequence.store(sequence, std::memory_order_release);
+
+  header_->write_sequence.store(sequence, std::memory_order_release);
+}
+
+void MarketDataPublisher::publish_level(std::string_view symbol, Side side,
+                                        uint64_t price, uint64_t quantity) {
+  if (!header_) {
+    return;
+  }
+
+  MarketDataUpdate update{};
+  update.publish_ns = steady_now_ns();
+  update.type = UpdateType::Level;
+  update.side = side;
+  copy_symbol(update.symbol, symbol);
+  if (side == Side::Buy) {
+    update.bid_price = price;
+    update.bid_quantity = quantity;
+  } else {
+    update.ask_price = price;
+    update.ask_quantity = quantity;
+  }
+  publish(update);
+}
+
+void MarketDataPublisher::publish_top_of_book(std::string_view symbol,
+                                              uint64_t bid_price,
+                                              uint64_t bid_quantity,
+                                              uint64_t ask_price,
+                                              uint64_t ask_quantity) {
+  if (!header_) {
+    return;
+  }
+
+  MarketDataUpdate update{};
+  update.publish_ns = steady_now_ns();
+  update.type = UpdateType::TopOfBook;
+  copy_symbol(update.symbol, symbol);
+  update.bid_price = bid_price;
+  update.bid_quantity = bid_quantity;
+  update.ask_price = ask_price;
+  update.ask_quantity = ask_quantity;
+  publish(update);
+}
+
+} // namespace hft
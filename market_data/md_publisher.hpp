@@ -0,0 +1,73 @@
+#pragma once
+
+#include "market_data/shm_ring.hpp"
+#include "order_book_listener.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace hft {
+
+// Single producer for a shared-memory market-data ring. Creates (or
+// re-creates) the POSIX shared memory object on open and unlinks it on close.
+//
+// The ring's write sequence is not synchronized: all publishes after an
+// open() must come from one thread. Debug builds assert this, fixing the
+// owner on the first publish. Books driven from different threads each need
+// their own publisher (and ring).
+class MarketDataPublisher {
+private:
+  std::string name_;
+  RingHeader *header_ = nullptr;
+  RingSlot *slots_ = nullptr;
+  size_t mapped_bytes_ = 0;
+  uint64_t mask_ = 0;
+  uint64_t sequence_ = 0; // Last published, only touched by the producer
+#ifndef NDEBUG
+  std::thread::id owner_; // Producer thread, set by the first publish
+#endif
+
+  void publish(const MarketDataUpdate &update);
+
+public:
+  MarketDataPublisher() = default;
+  ~MarketDataPublisher();
+
+  MarketDataPublisher(const MarketDataPublisher &) = delete;
+  MarketDataPublisher &operator=(const MarketDataPublisher &) = delete;
+
+  // name is a shm_open name ("/hft_md"); capacity is rounded up to a power
+  // of two. Returns false if the segment could not be created.
+  bool open(const std::string &name, uint32_t capacity = 65536);
+  void close();
+
+  void publish_level(std::string_view symbol, Side side, uint64_t price,
+                     uint64_t quantity);
+  void publish_top_of_book(std::string_view symbol, uint64_t bid_price,
+                           uint64_t bid_quantity, uint64_t ask_price,
+                           uint64_t ask_quantity);
+
+  uint64_t last_sequence() const { return sequence_; }
+};
+
+// Book listener that publishes L2 level changes and top-of-book changes of
+// every book it is attached to. Every copy shares the publisher, so the books
+// of one publisher (e.g. all books of a manager) must run on one thread.
+struct MarketDataListener : NullOrderBookListener {
+  MarketDataPublisher *publisher = nullptr;
+
+  void on_level_change(std::string_view symbol, Side side, uint64_t price,
+                       uint64_t quantity) {
+    publisher->publish_level(symbol, side, price, quantity);
+  }
+
+  void on_top_of_book(std::string_view symbol, uint64_t bid_price,
+                      uint64_t bid_quantity, uint64_t ask_price,
+                      uint64_t ask_quantity) {
+    publisher->publish_top_of_book(symbol, bid_price, bid_quantity, ask_price,
+                                   ask_quantity);
+  }
+};
+
+} // namespace hft
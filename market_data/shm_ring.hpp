@@ -0,0 +1,90 @@
+#pragma once
+
+#include "enums.hpp"
+#include "order.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hft {
+
+// Layout of the shared-memory market-data ring shared by MarketDataPublisher
+// and MarketDataConsumer. One producer writes, any number of consumers read;
+// the producer never waits for consumers and simply overwrites the oldest
+// slot, so slow consumers detect overruns through the slot sequence numbers.
+
+constexpr uint64_t MD_RING_MAGIC = 0x4846544d44524e47; // "HFTMDRNG"
+constexpr uint32_t MD_RING_VERSION = 1;
+constexpr size_t MD_SYMBOL_LENGTH = 8;
+
+enum class UpdateType : uint8_t {
+  TopOfBook = 0,
+  Level = 1
+};
+
+// One market-data update. Level updates fill the price/quantity pair of their
+// side; top-of-book updates fill both (empty side: price 0 / max, quantity 0).
+struct MarketDataUpdate {
+  uint64_t publish_ns; // steady_clock at publish time
+  UpdateType type;
+  Side side; // Level updates only
+  uint8_t reserved[6];
+  char symbol[MD_SYMBOL_LENGTH]; // NUL padded, truncated if longer
+  uint64_t bid_price;
+  uint64_t bid_quantity;
+  uint64_t ask_price;
+  uint64_t ask_quantity;
+};
+
+constexpr size_t MD_PAYLOAD_WORDS = sizeof(MarketDataUpdate) / sizeof(uint64_t);
+static_assert(sizeof(MarketDataUpdate) % sizeof(uint64_t) == 0,
+              "MarketDataUpdate must be a whole number of words");
+
+// A slot is a seqlock: sequence is 0 while the producer writes it and the
+// update's sequence number once complete. The payload is copied word by word
+// with relaxed atomics so concurrent reads are well defined.
+struct alignas(CACHE_LINE_SIZE) RingSlot {
+  std::atomic<uint64_t> sequence;
+  std::atomic<uint64_t> payload[MD_PAYLOAD_WORDS];
+};
+
+static_assert(sizeof(RingSlot) == CACHE_LINE_SIZE,
+              "RingSlot should occupy exactly one cache line");
+
+struct alignas(CACHE_LINE_SIZE) RingHeader {
+  std::atomic<uint64_t> magic; // Stored last, once the ring is initialised
+  uint32_t version;
+  uint32_t capacity; // Slots, power of two
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> write_sequence; // Last published
+};
+
+inline size_t ring_bytes(uint32_t capacity) {
+  return sizeof(RingHeader) + static_cast<size_t>(capacity) * sizeof(RingSlot);
+}
+
+inline RingSlot *ring_slots(RingHeader *header) {
+  return reinterpret_cast<RingSlot *>(header + 1);
+}
+
+inline const RingSlot *ring_slots(const RingHeader *header) {
+  return reinterpret_cast<const RingSlot *>(header + 1);
+}
+
+inline void store_payload(RingSlot &slot, const MarketDataUpdate &update) {
+  uint64_t words[MD_PAYLOAD_WORDS];
+  std::memcpy(words, &update, sizeof(words));
+  for (size_t i = 0; i < MD_PAYLOAD_WORDS; ++i) {
+    slot.payload[i].store(words[i], std::memory_order_relaxed);
+  }
+}
+
+inline void load_payload(const RingSlot &slot, MarketDataUpdate &update) {
+  uint64_t words[MD_PAYLOAD_WORDS];
+  for (size_t i = 0; i < MD_PAYLOAD_WORDS; ++i) {
+    words[i] = slot.payload[i].load(std::memory_order_relaxed);
+  }
+  std::memcpy(&update, words, sizeof(words));
+}
+
+} // namespace hft
@@ -18,16 +18,17 @@ struct alignas(CACHE_LINE_SIZE) Order {
   uint64_t price;
   uint32_t quantity;
   uint32_t timestamp;
+  uint32_t account;
   Side side;
   std::string_view symbol;
 
   Order(uint64_t id_, uint64_t price_, uint32_t quantity_, uint32_t timestamp_,
-        Side side_, std::string_view symbol_)
+        Side side_, std::string_view symbol_, uint32_t account_ = 0)
       : id(id_), price(price_), quantity(quantity_), timestamp(timestamp_),
-        side(side_), symbol(symbol_) {}
+        account(account_), side(side_), symbol(symbol_) {}
 
   //TODO: probably can remove
-  Order() : id(0), price(0), quantity(0), timestamp(0), side(Side::Buy), symbol("") {}
+  Order() : id(0), price(0), quantity(0), timestamp(0), account(0), side(Side::Buy), symbol("") {}
 };
 
 } // namespace hft
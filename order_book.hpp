@@ -1,50 +1,92 @@
 #pragma once
 
+#include "auction.hpp"
 #include "enums.hpp"
 #include "order.hpp"
+#include "order_book_listener.hpp"
 #include "order_pool.hpp"
 #include "price_level.hpp"
+#include <algorithm>
 #include <array>
+#include <iostream>
 #include <limits>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace hft {
  
-// Order book for single financial instrument/symbol
-class OrderBook {
+// Prices of one book taken together (empty sides as in get_best_bid/ask)
+struct BookPrices {
+  uint64_t reference = 0;
+  uint64_t best_bid = 0;
+  uint64_t best_ask = std::numeric_limits<uint64_t>::max();
+};
+
+// Order book for single financial instrument/symbol. Events are reported to
+// a compile-time Listener (see order_book_listener.hpp).
+template <typename Listener = NullOrderBookListener>
+class BasicOrderBook {
 private:
   std::string symbol_;
   std::array<PriceLevel*, MAX_PRICE_LEVELS> buy_levels_;
   std::array<PriceLevel*, MAX_PRICE_LEVELS> sell_levels_;
   size_t buy_level_count_ = 0;
   size_t sell_level_count_ = 0;
-  uint64_t last_trade_price_;
+  uint64_t last_trade_price_ = 0;
   uint32_t last_trade_quantity_ = 0;
+  bool auction_ = false; // Collect orders without matching until uncross()
   mutable std::shared_mutex mutex_; // Read-write lock for thread safety
   std::unordered_map<uint64_t, Order*> order_map_; //For fast order lookup by id
   OrderPool& order_pool_;
+  Listener listener_;
 
   // Internal methods
   PriceLevel* add_price_level(Side side, uint64_t price);
-  PriceLevel* find_price_level(Side side, uint64_t price);
+  PriceLevel* find_price_level(Side side, uint64_t price) const;
   void remove_price_level(Side side, uint64_t price);
 
+  // Remove an order while the book lock is already held
+  bool remove_order_locked(uint64_t order_id);
+
+  // Report the new aggregate quantity at a level (0 = level gone)
+  void publish_level(Side side, uint64_t price, uint64_t quantity);
+  void publish_levels();
+
+  // Fill volume from the best levels of one side at the auction price
+  void fill_auction_side(Side side, uint64_t price, uint64_t volume);
+
 public:
-  OrderBook(std::string symbol, OrderPool& order_pool);
-  ~OrderBook();
+  BasicOrderBook(std::string symbol, OrderPool& order_pool,
+                 Listener listener = Listener());
+  ~BasicOrderBook();
 
   // TODO -- copy/move ctors/assignment
  
-  bool add_order(uint64_t id, uint64_t price, uint32_t quantity, uint32_t timestamp, Side side);
+  bool add_order(uint64_t id, uint64_t price, uint32_t quantity, uint32_t timestamp, Side side,
+                 uint32_t account = 0);
   bool cancel_order(uint64_t order_id);
-  std::pair<uint32_t, uint64_t> process_market_order(uint32_t quantity, Side side);
+  // Sweep the opposite side; order_id is only used to report a reject.
+  // Rejected with AuctionInProgress while in auction mode.
+  std::pair<uint32_t, uint64_t> process_market_order(uint32_t quantity, Side side,
+                                                     uint64_t order_id = 0);
 
-  // Cross-orders
+  // Cross-orders. Each match executes at the price of the resting (earlier)
+  // order, like an exchange matching engine.
   void match_orders();
 
+  // Auction call phase: orders rest without matching until uncross() runs.
+  // match_orders does nothing and market orders are rejected.
+  void set_auction_mode(bool enabled);
+  bool in_auction() const;
+
+  // Execute all crossing quantity at the single equilibrium price (see
+  // find_equilibrium), in one pass. Does not leave auction mode.
+  AuctionResult uncross();
+
   // Get spread (difference between best bid and ask)
   uint64_t get_spread() const;
   
@@ -54,14 +96,690 @@ public:
   uint64_t get_best_bid() const;
   uint64_t get_best_ask() const;
 
+  // Total resting quantity at one price (0 if there is no such level)
+  uint64_t get_level_quantity(Side side, uint64_t price) const;
+
+  // Open quantity of a resting order (0 if it is not on the book)
+  uint32_t get_order_quantity(uint64_t order_id) const;
+
+  // Price used for risk bands: last trade, else mid (0 on an empty book)
+  uint64_t get_reference_price() const;
+
+  // Reference price and top of book read under one lock, so pre-trade
+  // checks see a consistent picture
+  BookPrices get_prices() const;
+
   // Get order book depth (numbers of bids and asks)
   std::pair<size_t, size_t> get_depth() const;
 
   std::string_view get_symbol() const;
 
+  Listener& listener() { return listener_; }
+  const Listener& listener() const { return listener_; }
+
+  // Mutate the listener under the book lock, then replay every resting
+  // level to it so a newly attached subscriber starts from a full picture
+  template <typename Fn>
+  void reconfigure_listener(Fn&& fn) {
+    std::unique_lock lock(mutex_);
+    fn(listener_);
+    publish_levels();
+  }
+
   // Print the order book, for debugging
   void print_book(size_t depth =5) const;
 
 };
 
+using OrderBook = BasicOrderBook<>;
+
+template <typename Listener>
+BasicOrderBook<Listener>::BasicOrderBook(std::string symbol,
+                                         OrderPool &order_pool,
+                                         Listener listener)
+    : symbol_(std::move(symbol)), order_pool_(order_pool),
+      listener_(std::move(listener)) {}
+
+template <typename Listener>
+BasicOrderBook<Listener>::~BasicOrderBook() {
+  // Clean up price levels
+  for (size_t i = 0; i < buy_level_count_; ++i) {
+    delete buy_levels_[i];
+  }
+
+  for (size_t i = 0; i < sell_level_count_; ++i) {
+    delete sell_levels_[i];
+  }
+}
+
+template <typename Listener>
+PriceLevel *BasicOrderBook<Listener>::add_price_level(Side side,
+                                                      uint64_t price) {
+  auto level = new PriceLevel(price);
+
+  if (side == Side::Buy) {
+    // keep buy-levels sorted in descending order (best bid first)
+    size_t i = 0;
+    while (i < buy_level_count_ && buy_levels_[i]->price() > price) {
+      ++i;
+    }
+
+    if (i < buy_level_count_) {
+      // Shift levels to make room
+      for (size_t j = buy_level_count_; j > i; --j) {
+        buy_levels_[j] = buy_levels_[j - 1];
+      }
+    }
+
+    buy_levels_[i] = level;
+    ++buy_level_count_;
+  } else {
+    // Sell
+    // Keep sell levels sorted in ascending order (best ask first)
+    size_t i = 0;
+    while (i < sell_level_count_ && sell_levels_[i]->price() < price) {
+      ++i;
+    }
+
+    if (i < sell_level_count_) {
+      // Shift levels to make room
+      for (size_t j = sell_level_count_; j > i; --j) {
+        sell_levels_[j] = sell_levels_[j - 1];
+      }
+    }
+
+    sell_levels_[i] = level;
+    ++sell_level_count_;
+  }
+
+  return level;
+}
+
+template <typename Listener>
+PriceLevel *BasicOrderBook<Listener>::find_price_level(Side side,
+                                                       uint64_t price) const {
+  if (side == Side::Buy) {
+    for (size_t i = 0; i < buy_level_count_; ++i) {
+      if (buy_levels_[i]->price() == price) {
+        return buy_levels_[i];
+      }
+    }
+  } else {
+    for (size_t i = 0; i < sell_level_count_; ++i) {
+      if (sell_levels_[i]->price() == price) {
+        return sell_levels_[i];
+      }
+    }
+  }
+  return nullptr;
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::remove_price_level(Side side, uint64_t price) {
+  if (side == Side::Buy) {
+    for (size_t i = 0; i < buy_level_count_; ++i) {
+      if (buy_levels_[i]->price() == price) {
+        delete buy_levels_[i];
+
+        // Shift levels to close the gap
+        for (size_t j = i; j < buy_level_count_ - 1; ++j) {
+          buy_levels_[j] = buy_levels_[j + 1];
+        }
+
+        --buy_level_count_;
+        break;
+      }
+    }
+  } else {
+    for (size_t i = 0; i < sell_level_count_; ++i) {
+      if (sell_levels_[i]->price() == price) {
+        delete sell_levels_[i];
+
+        // Shift levels to close the gap
+        for (size_t j = i; j < sell_level_count_ - 1; ++j) {
+          sell_levels_[j] = sell_levels_[j + 1];
+        }
+
+        --sell_level_count_;
+        break;
+      }
+    }
+  }
+}
+
+template <typename Listener>
+bool BasicOrderBook<Listener>::add_order(uint64_t id, uint64_t price,
+                                         uint32_t quantity, uint32_t timestamp,
+                                         Side side, uint32_t account) {
+  std::unique_lock lock(mutex_);
+
+  // Check if order alread exists
+  if (order_map_.find(id) != order_map_.end()) {
+    listener_.on_reject(id, RejectReason::DuplicateOrderId);
+    return false;
+  }
+
+  // Allocate new order
+  Order *order =
+      order_pool_.allocate(id, price, quantity, timestamp, side, symbol_,
+                           account);
+
+  // Add order to map for fast lookup
+  order_map_[id] = order;
+
+  // Find or create the price level
+  PriceLevel *level = find_price_level(side, price);
+  if (!level) {
+    if ((side == Side::Buy && buy_level_count_ >= MAX_PRICE_LEVELS) ||
+        (side == Side::Sell && sell_level_count_ >= MAX_PRICE_LEVELS)) {
+      // "Reject" order
+      order_map_.erase(id);
+      order_pool_.deallocate(order);
+      listener_.on_reject(id, RejectReason::TooManyPriceLevels);
+      return false;
+    }
+    level = add_price_level(side, price);
+  }
+
+  // Add order to the price level
+  if (!level->add_order(order)) {
+    // "Reject" order, price level full
+    order_map_.erase(id);
+    order_pool_.deallocate(order);
+    listener_.on_reject(id, RejectReason::PriceLevelFull);
+    return false;
+  }
+
+  listener_.on_accept(*order);
+  publish_level(side, price, level->total_quantity());
+
+  // Try to match orders immediately
+  return true;
+}
+
+template <typename Listener>
+bool BasicOrderBook<Listener>::cancel_order(uint64_t order_id) {
+  std::unique_lock lock(mutex_);
+
+  auto it = order_map_.find(order_id);
+  if (it == order_map_.end()) {
+    listener_.on_reject(order_id, RejectReason::UnknownOrder);
+    return false;
+  }
+
+  // Keep a copy for the listener, the pooled order is recycled on removal
+  Order cancelled = *it->second;
+  if (!remove_order_locked(order_id)) {
+    return false;
+  }
+
+  listener_.on_cancel(cancelled);
+  return true;
+}
+
+template <typename Listener>
+bool BasicOrderBook<Listener>::remove_order_locked(uint64_t order_id) {
+  auto it = order_map_.find(order_id);
+  if (it == order_map_.end()) {
+    return false;
+  }
+
+  Order *order = it->second;
+  PriceLevel *level = find_price_level(order->side, order->price);
+
+  if (!level) {
+    return false;
+  }
+
+  if (level->remove_order(order_id)) {
+    Side side = order->side;
+    uint64_t price = order->price;
+
+    // If price level is now empty, remove it
+    if (level->order_count() == 0) {
+      remove_price_level(side, price);
+      publish_level(side, price, 0);
+    } else {
+      publish_level(side, price, level->total_quantity());
+    }
+
+    // Return order to the order pool
+    order_pool_.deallocate(order);
+    order_map_.erase(it);
+    return true;
+  }
+  return false;
+}
+
+template <typename Listener>
+std::pair<uint32_t, uint64_t>
+BasicOrderBook<Listener>::process_market_order(uint32_t quantity, Side side,
+                                               uint64_t order_id) {
+  std::unique_lock lock(mutex_);
+
+  if (auction_) {
+    // No price to rest at and nothing to sweep until the uncross
+    listener_.on_reject(order_id, RejectReason::AuctionInProgress);
+    return {0, 0};
+  }
+
+  uint32_t filled_quantity = 0;
+  uint64_t total_cost = 0;
+
+  while (quantity > 0) {
+    // Get best price level on the opposite side
+    PriceLevel *level = nullptr;
+
+    if (side == Side::Buy && sell_level_count_ > 0) {
+      level = sell_levels_[0]; // Best ask
+    } else if (side == Side::Sell && buy_level_count_ > 0) {
+      level = buy_levels_[0]; // Best bid
+    }
+
+    if (!level) {
+      break; // No matching orders
+    }
+
+    Order *order = level->get_order(0);
+    if (!order) {
+      break;
+    }
+
+    uint64_t price = level->price();
+    uint32_t match_quantity = std::min(quantity, order->quantity);
+    filled_quantity += match_quantity;
+    total_cost += static_cast<uint64_t>(match_quantity) * price;
+
+    // Update matched order
+    order->quantity -= match_quantity;
+    level->reduce_quantity(match_quantity);
+    quantity -= match_quantity;
+
+    // Record last trade
+    last_trade_price_ = price;
+    last_trade_quantity_ = match_quantity;
+
+    listener_.on_fill(*order, price, match_quantity);
+    listener_.on_trade(symbol_, price, match_quantity, side);
+
+    if (order->quantity == 0) {
+      // Remove fully matched order (and the level, once it empties)
+      remove_order_locked(order->id);
+    } else {
+      publish_level(order->side, price, level->total_quantity());
+    }
+  }
+  return {filled_quantity, total_cost};
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::match_orders() {
+  std::unique_lock lock(mutex_);
+
+  if (auction_) {
+    return;
+  }
+
+  // While there are buy and sell orders that can match
+  while (buy_level_count_ > 0 && sell_level_count_ > 0) {
+    PriceLevel *best_bid = buy_levels_[0];
+    PriceLevel *best_ask = sell_levels_[0];
+
+    if (best_bid->price() >= best_ask->price()) {
+      // Orders can match -- get OLDEST order from each side
+      Order *buy_order = best_bid->get_order(0);
+      Order *sell_order = best_ask->get_order(0);
+
+      if (!buy_order || !sell_order) {
+        break;
+      }
+
+      // Match the orders
+      uint32_t match_quantity =
+          std::min(buy_order->quantity, sell_order->quantity);
+
+      // The later of the two orders is the one that crossed the book; it
+      // executes at the resting order's price
+      Side aggressor = buy_order->timestamp >= sell_order->timestamp
+                           ? Side::Buy
+                           : Side::Sell;
+
+      // Record the trade
+      last_trade_price_ =
+          aggressor == Side::Buy ? best_ask->price() : best_bid->price();
+      last_trade_quantity_ = match_quantity;
+
+      // Update the orders
+      buy_order->quantity -= match_quantity;
+      sell_order->quantity -= match_quantity;
+      best_bid->reduce_quantity(match_quantity);
+      best_ask->reduce_quantity(match_quantity);
+
+      listener_.on_fill(*buy_order, last_trade_price_, match_quantity);
+      listener_.on_fill(*sell_order, last_trade_price_, match_quantity);
+      listener_.on_trade(symbol_, last_trade_price_, match_quantity, aggressor);
+
+      // Remove orders that are fully filled
+      if (buy_order->quantity == 0) {
+        remove_order_locked(buy_order->id);
+      } else {
+        publish_level(Side::Buy, best_bid->price(), best_bid->total_quantity());
+      }
+      if (sell_order->quantity == 0) {
+        remove_order_locked(sell_order->id);
+      } else {
+        publish_level(Side::Sell, best_ask->price(), best_ask->total_quantity());
+      }
+    } else {
+      break; // No more matches possible
+    }
+  }
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::set_auction_mode(bool enabled) {
+  std::unique_lock lock(mutex_);
+  auction_ = enabled;
+}
+
+template <typename Listener>
+bool BasicOrderBook<Listener>::in_auction() const {
+  std::shared_lock lock(mutex_);
+  return auction_;
+}
+
+template <typename Listener>
+AuctionResult BasicOrderBook<Listener>::uncross() {
+  std::unique_lock lock(mutex_);
+
+  if (buy_level_count_ == 0 || sell_level_count_ == 0 ||
+      buy_levels_[0]->price() < sell_levels_[0]->price()) {
+    return {};
+  }
+
+  // Only bids at or above the best ask and asks at or below the best bid can
+  // trade, so the curves are built over that region only
+  uint64_t low = sell_levels_[0]->price();
+  uint64_t high = buy_levels_[0]->price();
+  size_t bids = 0;
+  while (bids < buy_level_count_ && buy_levels_[bids]->price() >= low) {
+    ++bids;
+  }
+  size_t asks = 0;
+  while (asks < sell_level_count_ && sell_levels_[asks]->price() <= high) {
+    ++asks;
+  }
+
+  // Merge both sides into one ascending price ladder
+  std::vector<uint64_t> prices, bid_quantity, ask_quantity;
+  prices.reserve(bids + asks);
+  bid_quantity.reserve(bids + asks);
+  ask_quantity.reserve(bids + asks);
+
+  size_t b = bids; // Bids are stored best (highest) first, walk backwards
+  size_t a = 0;
+  while (b > 0 || a < asks) {
+    uint64_t bid_price = b > 0 ? buy_levels_[b - 1]->price()
+                               : std::numeric_limits<uint64_t>::max();
+    uint64_t ask_price = a < asks ? sell_levels_[a]->price()
+                                  : std::numeric_limits<uint64_t>::max();
+    uint64_t price = std::min(bid_price, ask_price);
+
+    prices.push_back(price);
+    bid_quantity.push_back(
+        bid_price == price ? buy_levels_[--b]->total_quantity() : 0);
+    ask_quantity.push_back(
+        ask_price == price ? sell_levels_[a++]->total_quantity() : 0);
+  }
+
+  AuctionResult result =
+      find_equilibrium(prices.data(), bid_quantity.data(), ask_quantity.data(),
+                       prices.size(), last_trade_price_);
+  if (result.volume == 0) {
+    return result;
+  }
+
+  fill_auction_side(Side::Buy, result.price, result.volume);
+  fill_auction_side(Side::Sell, result.price, result.volume);
+
+  uint32_t quantity = static_cast<uint32_t>(std::min<uint64_t>(
+      result.volume, std::numeric_limits<uint32_t>::max()));
+  last_trade_price_ = result.price;
+  last_trade_quantity_ = quantity;
+
+  // The side left with surplus is the one that pushed the price
+  listener_.on_trade(symbol_, result.price, quantity,
+                     result.imbalance >= 0 ? Side::Buy : Side::Sell);
+  return result;
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::fill_auction_side(Side side, uint64_t price,
+                                                 uint64_t volume) {
+  auto &levels = side == Side::Buy ? buy_levels_ : sell_levels_;
+  size_t &count = side == Side::Buy ? buy_level_count_ : sell_level_count_;
+
+  // Levels consumed whole: every order is done, so skip per-order removal
+  // and drop the levels with a single shift afterwards
+  std::array<uint64_t, MAX_PRICE_LEVELS> emptied;
+  size_t consumed = 0;
+  while (consumed < count && volume >= levels[consumed]->total_quantity()) {
+    PriceLevel *level = levels[consumed];
+    for (size_t i = 0; i < level->order_count(); ++i) {
+      Order *order = level->get_order(i);
+      uint32_t quantity = order->quantity;
+      order->quantity = 0;
+      listener_.on_fill(*order, price, quantity);
+      order_map_.erase(order->id);
+      order_pool_.deallocate(order);
+    }
+
+    volume -= level->total_quantity();
+    emptied[consumed++] = level->price();
+    delete level;
+  }
+
+  if (consumed > 0) {
+    std::copy(levels.begin() + consumed, levels.begin() + count,
+              levels.begin());
+    count -= consumed;
+  }
+
+  // The rest comes out of the next level in queue order; it cannot empty
+  PriceLevel *partial = volume > 0 ? levels[0] : nullptr;
+  while (volume > 0) {
+    Order *order = partial->get_order(0);
+    uint32_t quantity =
+        static_cast<uint32_t>(std::min<uint64_t>(volume, order->quantity));
+    order->quantity -= quantity;
+    partial->reduce_quantity(quantity);
+    volume -= quantity;
+    listener_.on_fill(*order, price, quantity);
+
+    if (order->quantity == 0) {
+      partial->remove_order(order->id);
+      order_map_.erase(order->id);
+      order_pool_.deallocate(order);
+    }
+  }
+
+  for (size_t i = 0; i < consumed; ++i) {
+    publish_level(side, emptied[i], 0);
+  }
+  if (partial) {
+    publish_level(side, partial->price(), partial->total_quantity());
+  }
+}
+
+template <typename Listener>
+uint64_t BasicOrderBook<Listener>::get_spread() const {
+  std::shared_lock lock(mutex_);
+
+  if (buy_level_count_ > 0 && sell_level_count_ > 0) {
+    return sell_levels_[0]->price() - buy_levels_[0]->price();
+  }
+  return std::numeric_limits<uint64_t>::max();
+}
+
+template <typename Listener>
+uint64_t BasicOrderBook<Listener>::get_mid_price() const {
+  std::shared_lock lock(mutex_);
+
+  if (buy_level_count_ > 0 && sell_level_count_ > 0) {
+    return (buy_levels_[0]->price() + sell_levels_[0]->price()) / 2;
+  } else if (buy_level_count_ > 0) {
+    return buy_levels_[0]->price();
+  } else if (sell_level_count_ > 0) {
+    return sell_levels_[0]->price();
+  }
+  return 0;
+}
+
+template <typename Listener>
+uint64_t BasicOrderBook<Listener>::get_best_bid() const {
+  std::shared_lock lock(mutex_);
+
+  if (buy_level_count_ > 0) {
+    return buy_levels_[0]->price();
+  }
+  return 0;
+}
+
+template <typename Listener>
+uint64_t BasicOrderBook<Listener>::get_best_ask() const {
+  std::shared_lock lock(mutex_);
+
+  if (sell_level_count_ > 0) {
+    return sell_levels_[0]->price();
+  }
+  return std::numeric_limits<uint64_t>::max();
+}
+
+template <typename Listener>
+uint64_t BasicOrderBook<Listener>::get_level_quantity(Side side,
+                                                      uint64_t price) const {
+  std::shared_lock lock(mutex_);
+
+  PriceLevel *level = find_price_level(side, price);
+  return level ? level->total_quantity() : 0;
+}
+
+template <typename Listener>
+uint32_t BasicOrderBook<Listener>::get_order_quantity(uint64_t order_id) const {
+  std::shared_lock lock(mutex_);
+
+  auto it = order_map_.find(order_id);
+  return it != order_map_.end() ? it->second->quantity : 0;
+}
+
+template <typename Listener>
+uint64_t BasicOrderBook<Listener>::get_reference_price() const {
+  std::shared_lock lock(mutex_);
+
+  if (last_trade_price_ > 0) {
+    return last_trade_price_;
+  }
+  if (buy_level_count_ > 0 && sell_level_count_ > 0) {
+    return (buy_levels_[0]->price() + sell_levels_[0]->price()) / 2;
+  }
+  return 0;
+}
+
+template <typename Listener>
+BookPrices BasicOrderBook<Listener>::get_prices() const {
+  std::shared_lock lock(mutex_);
+
+  BookPrices prices;
+  if (buy_level_count_ > 0) {
+    prices.best_bid = buy_levels_[0]->price();
+  }
+  if (sell_level_count_ > 0) {
+    prices.best_ask = sell_levels_[0]->price();
+  }
+
+  if (last_trade_price_ > 0) {
+    prices.reference = last_trade_price_;
+  } else if (buy_level_count_ > 0 && sell_level_count_ > 0) {
+    prices.reference = (prices.best_bid + prices.best_ask) / 2;
+  }
+  return prices;
+}
+
+template <typename Listener>
+std::pair<size_t, size_t> BasicOrderBook<Listener>::get_depth() const {
+  std::shared_lock lock(mutex_);
+  return {buy_level_count_, sell_level_count_};
+}
+
+template <typename Listener>
+std::string_view BasicOrderBook<Listener>::get_symbol() const {
+  return symbol_;
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::publish_levels() {
+  for (size_t i = 0; i < buy_level_count_; ++i) {
+    publish_level(Side::Buy, buy_levels_[i]->price(),
+                  buy_levels_[i]->total_quantity());
+  }
+  for (size_t i = 0; i < sell_level_count_; ++i) {
+    publish_level(Side::Sell, sell_levels_[i]->price(),
+                  sell_levels_[i]->total_quantity());
+  }
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::publish_level(Side side, uint64_t price,
+                                             uint64_t quantity) {
+  listener_.on_level_change(symbol_, side, price, quantity);
+
+  if constexpr (listens_to_top_of_book<Listener>) {
+    // Levels are kept sorted, so the change touched the top of book iff the
+    // price is at or through the (new) best price on its side
+    bool top = side == Side::Buy
+                   ? buy_level_count_ == 0 || price >= buy_levels_[0]->price()
+                   : sell_level_count_ == 0 ||
+                         price <= sell_levels_[0]->price();
+    if (top) {
+      listener_.on_top_of_book(
+          symbol_, buy_level_count_ ? buy_levels_[0]->price() : 0,
+          buy_level_count_ ? buy_levels_[0]->total_quantity() : 0,
+          sell_level_count_ ? sell_levels_[0]->price()
+                            : std::numeric_limits<uint64_t>::max(),
+          sell_level_count_ ? sell_levels_[0]->total_quantity() : 0);
+    }
+  }
+}
+
+template <typename Listener>
+void BasicOrderBook<Listener>::print_book(size_t depth) const {
+    std::shared_lock lock(mutex_);
+    
+    std::cout << "\nOrder Book for " << symbol_ << "\n";
+    std::cout << "================================\n";
+    
+    // Print sells (in reverse order, highest first)
+    for (int i = std::min(sell_level_count_, depth) - 1; i >= 0; --i) {
+        std::cout << "SELL " << sell_levels_[i]->price() 
+                  << " x " << sell_levels_[i]->total_quantity() 
+                  << " (" << sell_levels_[i]->order_count() << " orders)\n";
+    }
+    
+    std::cout << "--------------------------------\n";
+    
+    // Print buys
+    for (size_t i = 0; i < std::min(buy_level_count_, depth); ++i) {
+        std::cout << "BUY  " << buy_levels_[i]->price() 
+                  << " x " << buy_levels_[i]->total_quantity() 
+                  << " (" << buy_levels_[i]->order_count() << " orders)\n";
+    }
+    
+    std::cout << "================================\n";
+    std::cout << "Spread: " << get_spread() << " | Mid Price: " << get_mid_price() << "\n";
+    std::cout << "Last Trade: " << last_trade_price_ << " x " << last_trade_quantity_ << "\n";
+}
+
+// The default instantiation is compiled once in order_book.cpp
+extern template class BasicOrderBook<NullOrderBookListener>;
+
 } // namespace hft
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "enums.hpp"
+#include "order.hpp"
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace hft {
+
+// Default (no-op) event listener for BasicOrderBook/BasicOrderBookManager.
+//
+// Listeners are injected as a template parameter, so hooks are resolved at
+// compile time and inlined into the matching code. A listener derives from
+// this struct and hides only the hooks it cares about; everything else stays
+// an empty inline call that the optimizer removes.
+struct NullOrderBookListener {
+  // Order rested on the book
+  void on_accept(const Order & /*order*/) {}
+
+  // Order or cancel request refused
+  void on_reject(uint64_t /*order_id*/, RejectReason /*reason*/) {}
+
+  // Resting order cancelled (order holds its last remaining quantity)
+  void on_cancel(const Order & /*order*/) {}
+
+  // Resting order (partially) filled; order.quantity is what is left
+  void on_fill(const Order & /*order*/, uint64_t /*price*/,
+               uint32_t /*quantity*/) {}
+
+  // Execution print, once per match
+  void on_trade(std::string_view /*symbol*/, uint64_t /*price*/,
+                uint32_t /*quantity*/, Side /*aggressor*/) {}
+
+  // New aggregate quantity at a price level, 0 when the level is removed
+  void on_level_change(std::string_view /*symbol*/, Side /*side*/,
+                       uint64_t /*price*/, uint64_t /*quantity*/) {}
+
+  // Best bid/ask after a change at the top of the book. An empty side is
+  // reported as price 0 (bid) / max (ask) with zero quantity. Only evaluated
+  // for listeners that provide this hook.
+  void on_top_of_book(std::string_view /*symbol*/, uint64_t /*bid_price*/,
+                      uint64_t /*bid_quantity*/, uint64_t /*ask_price*/,
+                      uint64_t /*ask_quantity*/) {}
+};
+
+// True when Listener hides NullOrderBookListener::on_top_of_book, so the book
+// only tracks the top of book for listeners that consume it
+template <typename Listener>
+constexpr bool listens_to_top_of_book =
+    !std::is_same_v<decltype(&Listener::on_top_of_book),
+                    decltype(&NullOrderBookListener::on_top_of_book)>;
+
+} // namespace hft
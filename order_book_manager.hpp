@@ -2,31 +2,179 @@
 
 #include "enums.hpp"
 #include "order_book.hpp"
+#include "order_book_listener.hpp"
+#include "pre_trade_risk.hpp"
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 
 namespace hft {
 
-// Class to manage multiple order books
+// Book listener used when a risk stage is enabled: keeps the risk exposure in
+// step with book events, then hands each event to the user listener.
+template <typename Listener, typename Risk>
+struct RiskTrackingListener : Listener {
+  Risk *risk;
+
+  RiskTrackingListener(Listener listener, Risk *risk_)
+      : Listener(std::move(listener)), risk(risk_) {}
+
+  void on_accept(const Order &order) {
+    risk->on_accept(order);
+    Listener::on_accept(order);
+  }
+
+  void on_cancel(const Order &order) {
+    risk->on_cancel(order);
+    Listener::on_cancel(order);
+  }
+
+  void on_fill(const Order &order, uint64_t price, uint32_t quantity) {
+    risk->on_fill(order, price, quantity);
+    Listener::on_fill(order, price, quantity);
+  }
+};
+
+template <typename Listener, typename Risk>
+using ManagedBookListener =
+    std::conditional_t<Risk::enabled, RiskTrackingListener<Listener, Risk>,
+                       Listener>;
+
+// Class to manage multiple order books. Every book gets a copy of the
+// manager's Listener, so events from all symbols reach the same hooks.
+// Risk selects an optional pre-trade risk stage (see pre_trade_risk.hpp).
+
+template <typename Listener = NullOrderBookListener,
+          typename Risk = NoRiskChecks>
+class BasicOrderBookManager {
+public:
+  using Book = BasicOrderBook<ManagedBookListener<Listener, Risk>>;
 
-class OrderBookManager {
 private:
-  std::unordered_map<std::string, std::unique_ptr<OrderBook>> order_books_;
+  std::unordered_map<std::string, std::unique_ptr<Book>> order_books_;
   OrderPool order_pool_;
   std::shared_mutex mutex_;
+  Listener listener_;
+  Risk risk_;
+
+  ManagedBookListener<Listener, Risk> make_book_listener();
 
 public:
-  OrderBookManager();
+  explicit BasicOrderBookManager(Listener listener = Listener());
 
   // Get or create an order book for a symbol
-  OrderBook *get_order_book(const std::string &symbol);
+  Book *get_order_book(const std::string &symbol);
 
   // Process a new order
   bool process_order(const std::string &symbol, uint64_t id, uint64_t price,
                      uint32_t quantity, uint32_t timestamp, OrderType type,
-                     Side side);
+                     Side side, uint32_t account = 0);
+
+  Listener &listener() { return listener_; }
+  Risk &risk() { return risk_; }
 };
 
+using OrderBookManager = BasicOrderBookManager<>;
+
+template <typename Listener, typename Risk>
+BasicOrderBookManager<Listener, Risk>::BasicOrderBookManager(Listener listener)
+    : order_pool_(100000), listener_(std::move(listener)) {}
+
+template <typename Listener, typename Risk>
+ManagedBookListener<Listener, Risk>
+BasicOrderBookManager<Listener, Risk>::make_book_listener() {
+  if constexpr (Risk::enabled) {
+    return {listener_, &risk_};
+  } else {
+    return listener_;
+  }
+}
+
+template <typename Listener, typename Risk>
+typename BasicOrderBookManager<Listener, Risk>::Book *
+BasicOrderBookManager<Listener, Risk>::get_order_book(
+    const std::string &symbol) {
+  std::unique_lock lock(mutex_);
+
+  auto it = order_books_.find(symbol);
+  if (it != order_books_.end()) {
+    return it->second.get();
+  }
+
+  // Create new order book
+  // TODO: review performance benefits of emplace
+  auto [new_it, success] = order_books_.emplace(
+      symbol,
+      std::make_unique<Book>(symbol, order_pool_, make_book_listener()));
+  return new_it->second.get();
+}
+
+template <typename Listener, typename Risk>
+bool BasicOrderBookManager<Listener, Risk>::process_order(
+    const std::string &symbol, uint64_t id, uint64_t price, uint32_t quantity,
+    uint32_t timestamp, OrderType type, Side side, uint32_t account) {
+  auto *book = get_order_book(symbol);
+
+  if constexpr (Risk::enabled) {
+    if (type != OrderType::Cancel) {
+      RejectReason reason;
+      const RiskLimits &limits = risk_.limits(account);
+      bool band = limits.price_band_bps > 0 && type == OrderType::Limit;
+      bool notional = type == OrderType::Market &&
+                      limits.max_open_notional !=
+                          std::numeric_limits<uint64_t>::max();
+
+      // One snapshot for the band reference and the market valuation. A
+      // writer on another thread can still move the book before the insert
+      // below; books are expected to be driven from one thread each.
+      BookPrices prices;
+      if (band || notional) {
+        prices = book->get_prices();
+      }
+      uint64_t reference = band ? prices.reference : 0;
+
+      // Market orders are valued at the opposite best for the notional limit
+      uint64_t check_price = type == OrderType::Limit ? price : 0;
+      if (notional) {
+        uint64_t best = side == Side::Buy ? prices.best_ask : prices.best_bid;
+        check_price =
+            best != std::numeric_limits<uint64_t>::max() ? best : 0;
+      }
+
+      if (!risk_.check(account, side, check_price, quantity, reference,
+                       reason)) {
+        listener_.on_reject(id, reason);
+        return false;
+      }
+    }
+  }
+
+  switch (type) {
+  case OrderType::Limit:
+    return book->add_order(id, price, quantity, timestamp, side, account);
+
+  case OrderType::Market: {
+    auto [filled, cost] = book->process_market_order(quantity, side, id);
+    if constexpr (Risk::enabled) {
+      risk_.on_execution(account, side, filled);
+    }
+    return filled > 0;
+  }
+
+  case OrderType::Cancel:
+    return book->cancel_order(id);
+
+  default:
+    listener_.on_reject(id, RejectReason::UnsupportedOrderType);
+    return false;
+  }
+}
+
+// The default instantiation is compiled once in order_book_manager.cpp
+extern template class BasicOrderBookManager<NullOrderBookListener>;
+
 } // namespace hft
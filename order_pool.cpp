@@ -18,7 +18,7 @@ OrderPool::OrderPool(size_t initial_size) {
 
 Order *OrderPool::allocate(uint64_t id, uint64_t price, uint32_t quantity,
                            uint32_t timestamp, Side side,
-                           std::string_view symbol) {
+                           std::string_view symbol, uint32_t account) {
   std::lock_guard<std::mutex> lock(mutex_);
   Order *order;
 
@@ -34,6 +34,7 @@ Order *OrderPool::allocate(uint64_t id, uint64_t price, uint32_t quantity,
   order->price = price;
   order->quantity = quantity;
   order->timestamp = timestamp;
+  order->account = account;
   order->side = side;
   order->symbol = symbol;
 
@@ -19,7 +19,8 @@ public:
   OrderPool(size_t initial_size = 10000);
 
   Order *allocate(uint64_t id, uint64_t price, uint32_t quantity,
-                  uint32_t timestamp, Side side, std::string_view symbol);
+                  uint32_t timestamp, Side side, std::string_view symbol,
+                  uint32_t account = 0);
 
   void deallocate(Order *order);
 };
@@ -0,0 +1,43 @@
+#include "pre_trade_risk.hpp"
+
+namespace hft {
+
+PreTradeRisk::PreTradeRisk() { limits_.fill(RiskLimits{}); }
+
+void PreTradeRisk::set_limits(uint32_t account, const RiskLimits &limits) {
+  if (account < MAX_ACCOUNTS) {
+    limits_[account] = limits;
+  }
+}
+
+void PreTradeRisk::set_default_limits(const RiskLimits &limits) {
+  limits_.fill(limits);
+}
+
+const RiskLimits &PreTradeRisk::limits(uint32_t account) const {
+  return limits_[account < MAX_ACCOUNTS ? account : 0];
+}
+
+int64_t PreTradeRisk::position(uint32_t account) const {
+  if (account >= MAX_ACCOUNTS) {
+    return 0;
+  }
+  return position_[account].load(std::memory_order_relaxed);
+}
+
+uint64_t PreTradeRisk::open_quantity(uint32_t account, Side side) const {
+  if (account >= MAX_ACCOUNTS) {
+    return 0;
+  }
+  const auto &open = side == Side::Buy ? open_buy_ : open_sell_;
+  return open[account].load(std::memory_order_relaxed);
+}
+
+uint64_t PreTradeRisk::open_notional(uint32_t account) const {
+  if (account >= MAX_ACCOUNTS) {
+    return 0;
+  }
+  return open_notional_[account].load(std::memory_order_relaxed);
+}
+
+} // namespace hft
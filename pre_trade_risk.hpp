@@ -0,0 +1,176 @@
+#pragma once
+
+#include "enums.hpp"
+#include "order.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace hft {
+
+constexpr size_t MAX_ACCOUNTS = 1024;
+
+// Per-account pre-trade limits. Defaults disable every check.
+struct RiskLimits {
+  uint32_t max_order_quantity = std::numeric_limits<uint32_t>::max();
+  uint32_t price_band_bps = 0; // Max distance from reference price, 0 = off
+  uint64_t max_position = std::numeric_limits<uint64_t>::max(); // Abs. net
+  uint64_t max_open_notional = std::numeric_limits<uint64_t>::max();
+};
+
+// Risk stage that checks nothing; BasicOrderBookManager compiles the
+// risk path out entirely when it is selected.
+struct NoRiskChecks {
+  static constexpr bool enabled = false;
+};
+
+// Inline pre-trade risk checks with per-account exposure tracking.
+//
+// Exposure lives in flat arrays indexed by account and is updated with
+// relaxed atomics from the book listener hooks (accept, fill, cancel), so
+// books on different threads never share a lock. A check reads a consistent
+// enough snapshot for limit enforcement; two orders racing on the same
+// account may both pass against the same exposure.
+class PreTradeRisk {
+private:
+  std::array<RiskLimits, MAX_ACCOUNTS> limits_;
+  std::array<std::atomic<int64_t>, MAX_ACCOUNTS> position_{};
+  std::array<std::atomic<uint64_t>, MAX_ACCOUNTS> open_buy_{};
+  std::array<std::atomic<uint64_t>, MAX_ACCOUNTS> open_sell_{};
+  std::array<std::atomic<uint64_t>, MAX_ACCOUNTS> open_notional_{};
+
+public:
+  static constexpr bool enabled = true;
+
+  PreTradeRisk();
+
+  // Configuration (not for the hot path)
+  void set_limits(uint32_t account, const RiskLimits &limits);
+  void set_default_limits(const RiskLimits &limits);
+  const RiskLimits &limits(uint32_t account) const;
+
+  // Check an incoming order. price is the limit price; market orders pass
+  // the opposite best they would execute at (0 on an empty side) so they
+  // count toward the notional limit. reference_price is 0 when the band
+  // check does not apply (market orders, or no reference on the book).
+  bool check(uint32_t account, Side side, uint64_t price, uint32_t quantity,
+             uint64_t reference_price, RejectReason &reason) const;
+
+  // Exposure updates, driven by book events
+  void on_accept(const Order &order);
+  void on_cancel(const Order &order);
+  void on_fill(const Order &order, uint64_t price, uint32_t quantity);
+
+  // Aggressive (market order) executions, reported by the manager
+  void on_execution(uint32_t account, Side side, uint32_t quantity);
+
+  // Exposure queries
+  int64_t position(uint32_t account) const;
+  uint64_t open_quantity(uint32_t account, Side side) const;
+  uint64_t open_notional(uint32_t account) const;
+};
+
+// Hot-path members are defined inline so the manager can fold them into
+// process_order.
+
+inline bool PreTradeRisk::check(uint32_t account, Side side, uint64_t price,
+                                uint32_t quantity, uint64_t reference_price,
+                                RejectReason &reason) const {
+  if (account >= MAX_ACCOUNTS) {
+    reason = RejectReason::UnknownAccount;
+    return false;
+  }
+
+  const RiskLimits &limits = limits_[account];
+
+  if (quantity > limits.max_order_quantity) {
+    reason = RejectReason::RiskMaxQuantity;
+    return false;
+  }
+
+  if (limits.price_band_bps > 0 && price > 0 && reference_price > 0) {
+    uint64_t distance = price > reference_price ? price - reference_price
+                                                : reference_price - price;
+    if (distance * 10000 > reference_price * limits.price_band_bps) {
+      reason = RejectReason::RiskPriceBand;
+      return false;
+    }
+  }
+
+  // Worst case position if every open order on this side fills
+  int64_t position = position_[account].load(std::memory_order_relaxed);
+  int64_t projected;
+  if (side == Side::Buy) {
+    projected = position +
+                static_cast<int64_t>(
+                    open_buy_[account].load(std::memory_order_relaxed)) +
+                quantity;
+  } else {
+    projected = -position +
+                static_cast<int64_t>(
+                    open_sell_[account].load(std::memory_order_relaxed)) +
+                quantity;
+  }
+  if (projected > 0 && static_cast<uint64_t>(projected) > limits.max_position) {
+    reason = RejectReason::RiskPosition;
+    return false;
+  }
+
+  uint64_t notional =
+      open_notional_[account].load(std::memory_order_relaxed) +
+      price * quantity;
+  if (notional > limits.max_open_notional) {
+    reason = RejectReason::RiskOpenNotional;
+    return false;
+  }
+
+  return true;
+}
+
+inline void PreTradeRisk::on_accept(const Order &order) {
+  if (order.account >= MAX_ACCOUNTS) {
+    return;
+  }
+  auto &open = order.side == Side::Buy ? open_buy_ : open_sell_;
+  open[order.account].fetch_add(order.quantity, std::memory_order_relaxed);
+  open_notional_[order.account].fetch_add(order.price * order.quantity,
+                                          std::memory_order_relaxed);
+}
+
+inline void PreTradeRisk::on_cancel(const Order &order) {
+  if (order.account >= MAX_ACCOUNTS) {
+    return;
+  }
+  auto &open = order.side == Side::Buy ? open_buy_ : open_sell_;
+  open[order.account].fetch_sub(order.quantity, std::memory_order_relaxed);
+  open_notional_[order.account].fetch_sub(order.price * order.quantity,
+                                          std::memory_order_relaxed);
+}
+
+inline void PreTradeRisk::on_fill(const Order &order, uint64_t /*price*/,
+                                  uint32_t quantity) {
+  if (order.account >= MAX_ACCOUNTS) {
+    return;
+  }
+  auto &open = order.side == Side::Buy ? open_buy_ : open_sell_;
+  open[order.account].fetch_sub(quantity, std::memory_order_relaxed);
+  // Open notional was booked at the limit price, release it the same way
+  open_notional_[order.account].fetch_sub(order.price * quantity,
+                                          std::memory_order_relaxed);
+  position_[order.account].fetch_add(
+      order.side == Side::Buy ? quantity : -static_cast<int64_t>(quantity),
+      std::memory_order_relaxed);
+}
+
+inline void PreTradeRisk::on_execution(uint32_t account, Side side,
+                                       uint32_t quantity) {
+  if (account >= MAX_ACCOUNTS) {
+    return;
+  }
+  position_[account].fetch_add(
+      side == Side::Buy ? quantity : -static_cast<int64_t>(quantity),
+      std::memory_order_relaxed);
+}
+
+} // namespace hft
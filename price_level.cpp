@@ -1,5 +1,7 @@
 #include "price_level.hpp"
 #include "order.hpp"
+#include <algorithm>
+#include <mutex>
 #include <shared_mutex>
 
 namespace hft {
@@ -22,10 +24,9 @@ bool PriceLevel::remove_order(uint64_t order_id) {
   for (size_t i = 0; i < order_count_; ++i) {
     if (orders_[i]->id == order_id) {
       total_quantity_ -= orders_[i]->quantity;
-      // Move the last order to fill the gap
-      if (i < order_count_ - 1) {
-        orders_[i] = orders_[order_count_ - 1];
-      }
+      // Shift the orders behind it forward to keep time priority
+      std::copy(orders_.begin() + i + 1, orders_.begin() + order_count_,
+                orders_.begin() + i);
       --order_count_;
       return true;
     }
@@ -33,6 +34,10 @@ bool PriceLevel::remove_order(uint64_t order_id) {
   return false;
 }
 
+void PriceLevel::reduce_quantity(uint64_t quantity) {
+  total_quantity_ -= quantity;
+}
+
 uint64_t PriceLevel::price() const { return price_; }
 
 uint64_t PriceLevel::total_quantity() const { return total_quantity_; }
@@ -23,9 +23,13 @@ public:
   // Add order to this price level
   bool add_order(Order* order);
 
-  // Remove order from this price level
+  // Remove order from this price level; the orders behind it keep their
+  // relative (time priority) order
   bool remove_order(uint64_t order_id);
 
+  // Account for a partial fill of a resting order at this level
+  void reduce_quantity(uint64_t quantity);
+
   // Getters w/ appropriate synchronization
   uint64_t price() const;
   uint64_t total_quantity() const;
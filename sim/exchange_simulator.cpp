@@ -0,0 +1,190 @@
+#include "sim/exchange_simulator.hpp"
+#include <algorithm>
+
+namespace hft {
+
+ExchangeSimulator::ExchangeSimulator(std::string symbol, LatencyModel latency,
+                                     uint64_t seed, size_t pool_size)
+    : pool_(pool_size), book_(std::move(symbol), pool_, SimBookListener{{}, this}),
+      latency_(latency), rng_(seed ? seed : 1) {
+  pending_.reserve(1024);
+}
+
+bool ExchangeSimulator::later(const Pending &a, const Pending &b) {
+  return a.time > b.time || (a.time == b.time && a.sequence > b.sequence);
+}
+
+uint64_t ExchangeSimulator::delay(uint64_t base, uint64_t &last_delivery) {
+  uint64_t jitter = 0;
+  if (latency_.jitter_ns > 0) {
+    // xorshift64*, cheap and reproducible per seed
+    rng_ ^= rng_ >> 12;
+    rng_ ^= rng_ << 25;
+    rng_ ^= rng_ >> 27;
+    jitter = (rng_ * 0x2545F4914F6CDD1DULL) % (latency_.jitter_ns + 1);
+  }
+
+  last_delivery = std::max(last_delivery, now_ + base + jitter);
+  return last_delivery;
+}
+
+void ExchangeSimulator::schedule(Pending pending) {
+  pending.sequence = ++pending_sequence_;
+  pending_.push_back(pending);
+  std::push_heap(pending_.begin(), pending_.end(), later);
+}
+
+ExchangeSimulator::Pending ExchangeSimulator::pop_pending() {
+  std::pop_heap(pending_.begin(), pending_.end(), later);
+  Pending pending = pending_.back();
+  pending_.pop_back();
+  return pending;
+}
+
+void ExchangeSimulator::apply(const ReplayEvent &event) {
+  ++stats_.replay_events;
+
+  switch (event.type) {
+  case ReplayEventType::Add:
+    book_.add_order(event.order_id, event.price, event.quantity,
+                    ++book_sequence_, event.side);
+    // Recorded flow never crosses itself, but it can cross our orders
+    if (!resting_.empty() && book_.get_best_bid() >= book_.get_best_ask()) {
+      book_.match_orders();
+    }
+    break;
+
+  case ReplayEventType::Cancel:
+    // May already be gone if our orders took its fills
+    book_.cancel_order(event.order_id);
+    break;
+
+  case ReplayEventType::Execute:
+    book_.process_market_order(event.quantity, event.side);
+    break;
+  }
+}
+
+uint64_t ExchangeSimulator::send_order(Side side, uint64_t price,
+                                       uint32_t quantity) {
+  SimOrder order;
+  order.id = SIM_OWN_ORDER_BIT | own_orders_.size();
+  order.price = price;
+  order.quantity = quantity;
+  order.side = side;
+  own_orders_.push_back(order);
+  ++stats_.own_orders;
+
+  schedule({delay(latency_.order_entry_ns, last_entry_delivery_), 0,
+            PendingType::NewOrder, order.id, 0, 0, {}});
+  return order.id;
+}
+
+void ExchangeSimulator::cancel_order(uint64_t order_id) {
+  schedule({delay(latency_.order_entry_ns, last_entry_delivery_), 0,
+            PendingType::CancelOrder, order_id, 0, 0, {}});
+}
+
+void ExchangeSimulator::arrive_order(uint64_t order_id) {
+  SimOrder &order = own_orders_[order_id & ~SIM_OWN_ORDER_BIT];
+
+  // Everything already resting at our price is ahead of us
+  order.volume_ahead = book_.get_level_quantity(order.side, order.price);
+  order.sequence = ++book_sequence_;
+  if (!book_.add_order(order.id, order.price, order.quantity, order.sequence,
+                       order.side)) {
+    return; // Rejected through the listener
+  }
+
+  order.live = true;
+  resting_.push_back(static_cast<uint32_t>(order_id & ~SIM_OWN_ORDER_BIT));
+
+  bool marketable = order.side == Side::Buy
+                        ? order.price >= book_.get_best_ask()
+                        : order.price <= book_.get_best_bid();
+  if (marketable) {
+    book_.match_orders();
+  }
+}
+
+void ExchangeSimulator::arrive_cancel(uint64_t order_id) {
+  if (!known(order_id) || !order(order_id).live) {
+    // Unknown id, rejected on entry, or filled/cancelled while in flight
+    schedule({delay(latency_.order_entry_ns, last_exit_delivery_), 0,
+              PendingType::Rejected, order_id, 0, 0, {}});
+    return;
+  }
+  book_.cancel_order(order_id);
+}
+
+void ExchangeSimulator::stop_resting(SimOrder &order) {
+  order.live = false;
+  uint32_t index = static_cast<uint32_t>(order.id & ~SIM_OWN_ORDER_BIT);
+  auto it = std::find(resting_.begin(), resting_.end(), index);
+  if (it != resting_.end()) {
+    *it = resting_.back();
+    resting_.pop_back();
+  }
+}
+
+void ExchangeSimulator::on_book_reject(uint64_t order_id) {
+  if (is_own(order_id)) {
+    schedule({delay(latency_.order_entry_ns, last_exit_delivery_), 0,
+              PendingType::Rejected, order_id, 0, 0, {}});
+  }
+}
+
+void ExchangeSimulator::on_book_cancel(const Order &cancelled) {
+  if (is_own(cancelled.id)) {
+    stop_resting(own_orders_[cancelled.id & ~SIM_OWN_ORDER_BIT]);
+    schedule({delay(latency_.order_entry_ns, last_exit_delivery_), 0,
+              PendingType::Cancelled, cancelled.id, 0, 0, {}});
+    return;
+  }
+
+  for (uint32_t index : resting_) {
+    SimOrder &order = own_orders_[index];
+    if (order.side == cancelled.side && order.price == cancelled.price &&
+        cancelled.timestamp < order.sequence) {
+      order.volume_ahead -= std::min<uint64_t>(order.volume_ahead,
+                                               cancelled.quantity);
+    }
+  }
+}
+
+void ExchangeSimulator::on_book_fill(const Order &filled, uint64_t price,
+                                     uint32_t quantity) {
+  if (is_own(filled.id)) {
+    SimOrder &order = own_orders_[filled.id & ~SIM_OWN_ORDER_BIT];
+    order.quantity = filled.quantity;
+    order.filled += quantity;
+    ++stats_.own_fills;
+    stats_.own_filled_quantity += quantity;
+    if (filled.quantity == 0) {
+      stop_resting(order);
+    }
+
+    schedule({delay(latency_.order_entry_ns, last_exit_delivery_), 0,
+              PendingType::Filled, filled.id, price, quantity, {}});
+    return;
+  }
+
+  for (uint32_t index : resting_) {
+    SimOrder &order = own_orders_[index];
+    if (order.side == filled.side && order.price == filled.price &&
+        filled.timestamp < order.sequence) {
+      order.volume_ahead -= std::min<uint64_t>(order.volume_ahead, quantity);
+    }
+  }
+}
+
+void ExchangeSimulator::on_book_top(uint64_t bid_price, uint64_t bid_quantity,
+                                    uint64_t ask_price,
+                                    uint64_t ask_quantity) {
+  ++stats_.market_data_updates;
+  schedule({delay(latency_.market_data_ns, last_md_delivery_), 0,
+            PendingType::MarketData, 0, 0, 0,
+            {now_, bid_price, bid_quantity, ask_price, ask_quantity}});
+}
+
+} // namespace hft
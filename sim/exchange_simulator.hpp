@@ -0,0 +1,262 @@
+#pragma once
+
+#include "enums.hpp"
+#include "order_book.hpp"
+#include "order_book_listener.hpp"
+#include "order_pool.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hft {
+
+// Our order ids carry this bit so they never collide with recorded ids
+constexpr uint64_t SIM_OWN_ORDER_BIT = uint64_t{1} << 63;
+
+enum class ReplayEventType : uint8_t {
+  Add = 0,    // Recorded limit order rests
+  Cancel = 1, // Recorded order leaves the book
+  Execute = 2 // Recorded marketable flow takes quantity from the book
+};
+
+// One recorded market-by-order event
+struct ReplayEvent {
+  uint64_t timestamp_ns = 0; // Exchange time, non-decreasing
+  uint64_t order_id = 0;     // Add/Cancel
+  uint64_t price = 0;        // Add
+  uint32_t quantity = 0;     // Add/Execute
+  Side side = Side::Buy;     // Add: order side, Execute: aggressor side
+  ReplayEventType type = ReplayEventType::Add;
+};
+
+// One-way delays between the strategy and the simulated exchange. Each
+// message takes base + uniform [0, jitter_ns]; messages on one path never
+// overtake each other.
+struct LatencyModel {
+  uint64_t order_entry_ns = 0; // Orders/cancels in, acks/fills back
+  uint64_t market_data_ns = 0; // Book updates out
+  uint64_t jitter_ns = 0;
+};
+
+struct SimTopOfBook {
+  uint64_t exchange_ns = 0; // When the book looked like this
+  uint64_t bid_price = 0;
+  uint64_t bid_quantity = 0;
+  uint64_t ask_price = 0;
+  uint64_t ask_quantity = 0;
+};
+
+// One of our orders, as the exchange sees it
+struct SimOrder {
+  uint64_t id = 0;
+  uint64_t price = 0;
+  uint32_t quantity = 0;     // Remaining
+  uint32_t filled = 0;
+  uint64_t volume_ahead = 0; // Quantity queued before us at our level
+  uint32_t sequence = 0;     // Arrival order on the book
+  Side side = Side::Buy;
+  bool live = false;         // Resting on the book
+};
+
+struct SimStats {
+  uint64_t replay_events = 0;
+  uint64_t own_orders = 0;
+  uint64_t own_fills = 0;
+  uint64_t own_filled_quantity = 0;
+  uint64_t market_data_updates = 0;
+};
+
+class ExchangeSimulator;
+
+// Book listener that keeps our orders' queue positions current and turns
+// book changes into delayed strategy notifications.
+struct SimBookListener : NullOrderBookListener {
+  ExchangeSimulator *sim = nullptr;
+
+  void on_reject(uint64_t order_id, RejectReason reason);
+  void on_cancel(const Order &order);
+  void on_fill(const Order &order, uint64_t price, uint32_t quantity);
+  void on_top_of_book(std::string_view symbol, uint64_t bid_price,
+                      uint64_t bid_quantity, uint64_t ask_price,
+                      uint64_t ask_quantity);
+};
+
+// Default (no-op) strategy; strategies derive from it and hide the hooks
+// they need, like book listeners do.
+struct NullStrategy {
+  void on_market_data(ExchangeSimulator & /*sim*/,
+                      const SimTopOfBook & /*top*/) {}
+  void on_fill(ExchangeSimulator & /*sim*/, const SimOrder & /*order*/,
+               uint64_t /*price*/, uint32_t /*quantity*/) {}
+  void on_cancel(ExchangeSimulator & /*sim*/, uint64_t /*order_id*/) {}
+  void on_reject(ExchangeSimulator & /*sim*/, uint64_t /*order_id*/) {}
+};
+
+// Replays one symbol's recorded flow through a BasicOrderBook and injects a
+// strategy's orders into it under a LatencyModel.
+//
+// Recorded and own events are merged in time order on a single thread; the
+// strategy only sees the book through delayed top-of-book updates and learns
+// about fills/cancels after the order-entry delay. Our resting orders sit in
+// the real price-level queues, and their volume ahead is updated on every
+// cancel or fill in front of them.
+class ExchangeSimulator {
+private:
+  enum class PendingType : uint8_t {
+    NewOrder,    // Strategy -> exchange
+    CancelOrder, // Strategy -> exchange
+    MarketData,  // Exchange -> strategy
+    Filled,      // Exchange -> strategy
+    Cancelled,   // Exchange -> strategy
+    Rejected     // Exchange -> strategy
+  };
+
+  struct Pending {
+    uint64_t time;
+    uint64_t sequence; // Keeps same-time events in send order
+    PendingType type;
+    uint64_t order_id;
+    uint64_t price;
+    uint32_t quantity;
+    SimTopOfBook top;
+  };
+
+  OrderPool pool_;
+  BasicOrderBook<SimBookListener> book_;
+  LatencyModel latency_;
+  uint64_t rng_;
+  uint64_t now_ = 0;
+  uint32_t book_sequence_ = 0;
+  uint64_t pending_sequence_ = 0;
+  uint64_t last_entry_delivery_ = 0; // Per-path FIFO
+  uint64_t last_exit_delivery_ = 0;
+  uint64_t last_md_delivery_ = 0;
+
+  std::vector<Pending> pending_; // Min-heap on (time, sequence)
+  std::vector<SimOrder> own_orders_;
+  std::vector<uint32_t> resting_; // Indices of our live orders
+  SimStats stats_;
+
+  // Min-heap order on (time, sequence)
+  static bool later(const Pending &a, const Pending &b);
+
+  uint64_t delay(uint64_t base, uint64_t &last_delivery);
+  void schedule(Pending pending);
+  Pending pop_pending();
+
+  void apply(const ReplayEvent &event);
+  void arrive_order(uint64_t order_id);
+  void arrive_cancel(uint64_t order_id);
+  void stop_resting(SimOrder &order);
+
+  static bool is_own(uint64_t order_id) {
+    return (order_id & SIM_OWN_ORDER_BIT) != 0;
+  }
+  // One of ours that send_order handed out
+  bool known(uint64_t order_id) const {
+    return is_own(order_id) &&
+           (order_id & ~SIM_OWN_ORDER_BIT) < own_orders_.size();
+  }
+
+  friend struct SimBookListener;
+  void on_book_reject(uint64_t order_id);
+  void on_book_cancel(const Order &order);
+  void on_book_fill(const Order &order, uint64_t price, uint32_t quantity);
+  void on_book_top(uint64_t bid_price, uint64_t bid_quantity,
+                   uint64_t ask_price, uint64_t ask_quantity);
+
+public:
+  ExchangeSimulator(std::string symbol, LatencyModel latency = LatencyModel(),
+                    uint64_t seed = 1, size_t pool_size = 1 << 16);
+
+  ExchangeSimulator(const ExchangeSimulator &) = delete;
+  ExchangeSimulator &operator=(const ExchangeSimulator &) = delete;
+
+  // Replay events (sorted by timestamp) against strategy; returns once both
+  // the replay and every in-flight message are done
+  template <typename Strategy>
+  SimStats run(const ReplayEvent *events, size_t count, Strategy &strategy);
+
+  // Strategy side: the order reaches the exchange after the entry delay.
+  // Returns our order id.
+  uint64_t send_order(Side side, uint64_t price, uint32_t quantity);
+  void cancel_order(uint64_t order_id);
+
+  // order_id must come from send_order
+  const SimOrder &order(uint64_t order_id) const {
+    assert(known(order_id));
+    return own_orders_[order_id & ~SIM_OWN_ORDER_BIT];
+  }
+
+  uint64_t now() const { return now_; }
+  const BasicOrderBook<SimBookListener> &book() const { return book_; }
+  const SimStats &stats() const { return stats_; }
+};
+
+template <typename Strategy>
+SimStats ExchangeSimulator::run(const ReplayEvent *events, size_t count,
+                                Strategy &strategy) {
+  size_t next = 0;
+
+  while (next < count || !pending_.empty()) {
+    // Recorded events win ties: our messages arrive behind the market
+    if (next < count &&
+        (pending_.empty() || events[next].timestamp_ns <= pending_.front().time)) {
+      now_ = events[next].timestamp_ns;
+      apply(events[next++]);
+      continue;
+    }
+
+    Pending pending = pop_pending();
+    now_ = pending.time;
+
+    switch (pending.type) {
+    case PendingType::NewOrder:
+      arrive_order(pending.order_id);
+      break;
+    case PendingType::CancelOrder:
+      arrive_cancel(pending.order_id);
+      break;
+    case PendingType::MarketData:
+      strategy.on_market_data(*this, pending.top);
+      break;
+    case PendingType::Filled:
+      strategy.on_fill(*this, order(pending.order_id), pending.price,
+                       pending.quantity);
+      break;
+    case PendingType::Cancelled:
+      strategy.on_cancel(*this, pending.order_id);
+      break;
+    case PendingType::Rejected:
+      strategy.on_reject(*this, pending.order_id);
+      break;
+    }
+  }
+  return stats_;
+}
+
+inline void SimBookListener::on_reject(uint64_t order_id,
+                                       RejectReason /*reason*/) {
+  sim->on_book_reject(order_id);
+}
+
+inline void SimBookListener::on_cancel(const Order &order) {
+  sim->on_book_cancel(order);
+}
+
+inline void SimBookListener::on_fill(const Order &order, uint64_t price,
+                                     uint32_t quantity) {
+  sim->on_book_fill(order, price, quantity);
+}
+
+inline void SimBookListener::on_top_of_book(std::string_view /*symbol*/,
+                                            uint64_t bid_price,
+                                            uint64_t bid_quantity,
+                                            uint64_t ask_price,
+                                            uint64_t ask_quantity) {
+  sim->on_book_top(bid_price, bid_quantity, ask_price, ask_quantity);
+}
+
+} // namespace hft
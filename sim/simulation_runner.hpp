@@ -0,0 +1,56 @@
+#pragma once
+
+#include "sim/exchange_simulator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hft {
+
+// Recorded flow for one symbol
+struct SymbolReplay {
+  std::string symbol;
+  std::vector<ReplayEvent> events;
+};
+
+// Simulate every symbol on its own ExchangeSimulator. Symbols share nothing,
+// so they are handed out one at a time to threads (0 = one per hardware
+// thread). strategies[i] trades replays[i] and holds its results afterwards;
+// each symbol gets a fixed jitter seed, so runs are reproducible regardless
+// of the thread count.
+template <typename Strategy>
+std::vector<SimStats> simulate_symbols(const std::vector<SymbolReplay> &replays,
+                                       std::vector<Strategy> &strategies,
+                                       LatencyModel latency = LatencyModel(),
+                                       unsigned threads = 0) {
+  std::vector<SimStats> results(replays.size());
+  std::atomic<size_t> next{0};
+
+  auto worker = [&]() {
+    for (size_t i = next++; i < replays.size(); i = next++) {
+      ExchangeSimulator sim(replays[i].symbol, latency, i + 1);
+      results[i] = sim.run(replays[i].events.data(), replays[i].events.size(),
+                           strategies[i]);
+    }
+  };
+
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads = static_cast<unsigned>(
+      std::min<size_t>(threads, std::max<size_t>(replays.size(), 1)));
+
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t) {
+    pool.emplace_back(worker);
+  }
+  worker(); // The calling thread works too
+  for (auto &thread : pool) {
+    thread.join();
+  }
+  return results;
+}
+
+} // namespace hft
@@ -0,0 +1,58 @@
+#include "sim/synthetic_replay.hpp"
+#include <random>
+
+namespace hft {
+
+std::vector<ReplayEvent> generate_synthetic_replay(uint64_t seed, size_t events,
+                                                   uint64_t mid_price) {
+  constexpr uint64_t LEVELS_PER_SIDE = 32;
+  constexpr size_t TARGET_RESTING = 2000; // ~30 orders per level
+
+  std::mt19937_64 rng(seed);
+  std::vector<ReplayEvent> replay;
+  replay.reserve(events);
+
+  // Live recorded orders, for picking cancels
+  std::vector<uint64_t> live;
+  live.reserve(TARGET_RESTING * 2);
+
+  uint64_t timestamp = 34'200'000'000'000; // 09:30 in ns since midnight
+  uint64_t next_id = 1;
+
+  while (replay.size() < events) {
+    timestamp += 1 + rng() % 2000;
+    ReplayEvent event;
+    event.timestamp_ns = timestamp;
+
+    // Add more while the book is thin, cancel more while it is thick
+    uint64_t roll = rng() % 100;
+    uint64_t add_share = live.size() < TARGET_RESTING ? 60 : 40;
+
+    if (roll < add_share || live.empty()) {
+      uint64_t ticks = 1 + rng() % LEVELS_PER_SIDE;
+      event.type = ReplayEventType::Add;
+      event.order_id = next_id++;
+      event.side = rng() % 2 ? Side::Buy : Side::Sell;
+      event.price = event.side == Side::Buy ? mid_price - ticks
+                                            : mid_price + ticks;
+      event.quantity = static_cast<uint32_t>(1 + rng() % 10) * 100;
+      live.push_back(event.order_id);
+    } else if (roll < 92) {
+      size_t pick = rng() % live.size();
+      event.type = ReplayEventType::Cancel;
+      event.order_id = live[pick];
+      live[pick] = live.back();
+      live.pop_back();
+    } else {
+      // Executions leave their filled orders in live; the later cancel of a
+      // filled order is rejected by the book, as it would be on replay
+      event.type = ReplayEventType::Execute;
+      event.side = rng() % 2 ? Side::Buy : Side::Sell;
+      event.quantity = static_cast<uint32_t>(1 + rng() % 5) * 100;
+    }
+    replay.push_back(event);
+  }
+  return replay;
+}
+
+} // namespace hft
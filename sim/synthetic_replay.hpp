@@ -0,0 +1,17 @@
+#pragma once
+
+#include "sim/exchange_simulator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hft {
+
+// Market-by-order flow with the shape of a recorded session, for tests,
+// benchmarks and dry runs of the simulator: mostly adds and cancels within
+// a few ticks of a fixed mid, with occasional executions at the touch. The
+// book it builds never crosses and stays within the PriceLevel limits.
+std::vector<ReplayEvent> generate_synthetic_replay(uint64_t seed, size_t events,
+                                                   uint64_t mid_price = 100'00);
+
+} // namespace hft
@@ -0,0 +1,235 @@
+#include "gtest/gtest.h"
+#include "auction.hpp"
+#include "order_book.hpp"
+#include "order_book_manager.hpp"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Straightforward O(n^2) equilibrium search with the same tie-break rules
+hft::AuctionResult reference_equilibrium(const std::vector<uint64_t>& prices,
+                                         const std::vector<uint64_t>& bids,
+                                         const std::vector<uint64_t>& asks,
+                                         uint64_t reference_price) {
+    hft::AuctionResult best;
+    uint64_t best_surplus = 0, best_distance = 0;
+    for (size_t i = 0; i < prices.size(); ++i) {
+        uint64_t demand = 0, supply = 0;
+        for (size_t j = i; j < prices.size(); ++j) demand += bids[j];
+        for (size_t j = 0; j <= i; ++j) supply += asks[j];
+
+        uint64_t volume = std::min(demand, supply);
+        uint64_t surplus = demand > supply ? demand - supply : supply - demand;
+        uint64_t distance = reference_price == 0 ? 0
+            : (prices[i] > reference_price ? prices[i] - reference_price : reference_price - prices[i]);
+        if (volume == 0) continue;
+
+        if (volume > best.volume ||
+            (volume == best.volume && (surplus < best_surplus ||
+                                       (surplus == best_surplus && distance < best_distance)))) {
+            best = {prices[i], volume, static_cast<int64_t>(demand) - static_cast<int64_t>(supply)};
+            best_surplus = surplus;
+            best_distance = distance;
+        }
+    }
+    return best;
+}
+
+struct RejectRecorder : hft::NullOrderBookListener {
+    std::vector<std::pair<uint64_t, hft::RejectReason>>* rejects;
+
+    void on_reject(uint64_t order_id, hft::RejectReason reason) {
+        rejects->emplace_back(order_id, reason);
+    }
+};
+
+struct FillRecorder : hft::NullOrderBookListener {
+    std::vector<std::pair<uint64_t, uint64_t>>* fills; // id, price
+    uint64_t* traded;
+
+    void on_fill(const hft::Order& order, uint64_t price, uint32_t) {
+        fills->emplace_back(order.id, price);
+    }
+    void on_trade(std::string_view, uint64_t, uint32_t quantity, hft::Side) {
+        *traded += quantity;
+    }
+};
+
+std::string kernel_name(const ::testing::TestParamInfo<hft::AuctionKernel>& info) {
+    switch (info.param) {
+    case hft::AuctionKernel::Scalar: return "Scalar";
+    case hft::AuctionKernel::SSE2: return "SSE2";
+    case hft::AuctionKernel::AVX2: return "AVX2";
+    }
+    return "Unknown";
+}
+
+} // namespace
+
+// Every auction test runs once per kernel; kernels the CPU lacks are skipped
+class AuctionTest : public ::testing::TestWithParam<hft::AuctionKernel> {
+protected:
+    void SetUp() override {
+        if (!hft::set_auction_kernel(GetParam())) {
+            GTEST_SKIP() << "kernel not supported on this CPU";
+        }
+        ASSERT_EQ(hft::auction_kernel(), GetParam());
+    }
+    void TearDown() override { hft::set_auction_kernel(hft::detected_auction_kernel()); }
+};
+
+INSTANTIATE_TEST_SUITE_P(Kernels, AuctionTest,
+                         ::testing::Values(hft::AuctionKernel::Scalar, hft::AuctionKernel::SSE2,
+                                           hft::AuctionKernel::AVX2),
+                         kernel_name);
+
+TEST_P(AuctionTest, PrefixSumMatchesScalar) {
+    std::mt19937_64 rng(7);
+    for (size_t n : {0u, 1u, 2u, 3u, 4u, 5u, 7u, 8u, 31u, 1000u}) {
+        std::vector<uint64_t> in(n), out(n);
+        for (auto& v : in) v = rng() % 100000;
+        hft::prefix_sum(in.data(), out.data(), n);
+
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += in[i];
+            ASSERT_EQ(out[i], sum) << "n=" << n << " i=" << i;
+        }
+    }
+}
+
+TEST_P(AuctionTest, KnownEquilibrium) {
+    // Demand:  100:600 101:400 102:300 103:100
+    // Supply:  100:100 101:300 102:500 103:700
+    std::vector<uint64_t> prices{100, 101, 102, 103};
+    std::vector<uint64_t> bids{200, 100, 200, 100};
+    std::vector<uint64_t> asks{100, 200, 200, 200};
+
+    auto result = hft::find_equilibrium(prices.data(), bids.data(), asks.data(), prices.size(), 0);
+    EXPECT_EQ(result.price, 101u);
+    EXPECT_EQ(result.volume, 300u);
+    EXPECT_EQ(result.imbalance, 100);
+
+    // Nothing crosses
+    std::vector<uint64_t> no_bids{0, 0, 0, 0};
+    EXPECT_EQ(hft::find_equilibrium(prices.data(), no_bids.data(), asks.data(), 4, 0).volume, 0u);
+}
+
+TEST_P(AuctionTest, ReferencePriceBreaksTies) {
+    // Volume 100 with zero imbalance anywhere in 100..102
+    std::vector<uint64_t> prices{100, 101, 102};
+    std::vector<uint64_t> bids{0, 0, 100};
+    std::vector<uint64_t> asks{100, 0, 0};
+
+    EXPECT_EQ(hft::find_equilibrium(prices.data(), bids.data(), asks.data(), 3, 0).price, 100u);
+    EXPECT_EQ(hft::find_equilibrium(prices.data(), bids.data(), asks.data(), 3, 101).price, 101u);
+    EXPECT_EQ(hft::find_equilibrium(prices.data(), bids.data(), asks.data(), 3, 500).price, 102u);
+}
+
+TEST_P(AuctionTest, RandomCurvesMatchReference) {
+    std::mt19937_64 rng(42);
+    for (int round = 0; round < 200; ++round) {
+        size_t n = 1 + rng() % 67;
+        std::vector<uint64_t> prices(n), bids(n), asks(n);
+        for (size_t i = 0; i < n; ++i) {
+            prices[i] = 1000 + i * (1 + rng() % 3);
+            bids[i] = rng() % 4 == 0 ? 0 : rng() % 500;
+            asks[i] = rng() % 4 == 0 ? 0 : rng() % 500;
+        }
+        uint64_t reference_price = rng() % 2 ? prices[rng() % n] : 0;
+
+        auto expected = reference_equilibrium(prices, bids, asks, reference_price);
+        auto actual = hft::find_equilibrium(prices.data(), bids.data(), asks.data(), n, reference_price);
+        ASSERT_EQ(actual.price, expected.price) << "round " << round;
+        ASSERT_EQ(actual.volume, expected.volume) << "round " << round;
+        ASSERT_EQ(actual.imbalance, expected.imbalance) << "round " << round;
+    }
+}
+
+TEST_P(AuctionTest, BookCollectsThenUncrosses) {
+    std::vector<std::pair<uint64_t, uint64_t>> fills;
+    uint64_t traded = 0;
+    hft::OrderPool pool(100);
+    hft::BasicOrderBook<FillRecorder> book("AAPL", pool, {{}, &fills, &traded});
+
+    book.set_auction_mode(true);
+    EXPECT_TRUE(book.in_auction());
+
+    book.add_order(1, 103, 100, 1, hft::Side::Buy);
+    book.add_order(2, 102, 200, 2, hft::Side::Buy);
+    book.add_order(3, 101, 100, 3, hft::Side::Buy);
+    book.add_order(4, 100, 200, 4, hft::Side::Buy);
+    book.add_order(5, 100, 100, 5, hft::Side::Sell);
+    book.add_order(6, 101, 200, 6, hft::Side::Sell);
+    book.add_order(7, 102, 200, 7, hft::Side::Sell);
+    book.add_order(8, 103, 200, 8, hft::Side::Sell);
+
+    // Collected, not matched
+    book.match_orders();
+    EXPECT_EQ(book.process_market_order(50, hft::Side::Buy).first, 0u);
+    EXPECT_TRUE(fills.empty());
+    EXPECT_EQ(book.get_depth(), std::make_pair(size_t{4}, size_t{4}));
+
+    auto result = book.uncross();
+    EXPECT_EQ(result.price, 101u);
+    EXPECT_EQ(result.volume, 300u);
+    EXPECT_EQ(traded, 300u);
+    for (const auto& fill : fills) {
+        EXPECT_EQ(fill.second, 101u);
+    }
+
+    // Bids 103 and 102 fully done, asks 100 and 101 fully done
+    EXPECT_EQ(book.get_best_bid(), 101u);
+    EXPECT_EQ(book.get_best_ask(), 102u);
+    EXPECT_EQ(book.get_depth(), std::make_pair(size_t{2}, size_t{2}));
+    EXPECT_EQ(book.get_reference_price(), 101u);
+    EXPECT_FALSE(book.cancel_order(1));
+    EXPECT_FALSE(book.cancel_order(6));
+    EXPECT_TRUE(book.cancel_order(3));
+
+    // Nothing left crossing
+    EXPECT_EQ(book.uncross().volume, 0u);
+}
+
+TEST_P(AuctionTest, UncrossLeavesPartialLevel) {
+    hft::OrderPool pool(100);
+    hft::OrderBook book("AAPL", pool);
+    book.set_auction_mode(true);
+
+    book.add_order(1, 101, 50, 1, hft::Side::Buy);
+    book.add_order(2, 101, 50, 2, hft::Side::Buy);
+    book.add_order(3, 100, 70, 3, hft::Side::Sell);
+
+    auto result = book.uncross();
+    EXPECT_EQ(result.volume, 70u);
+    EXPECT_EQ(result.imbalance, 30);
+    EXPECT_EQ(book.get_best_bid(), 101u);
+    EXPECT_EQ(book.get_best_ask(), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(book.get_depth(), std::make_pair(size_t{1}, size_t{0}));
+
+    // Continuous trading again once the auction ends
+    book.set_auction_mode(false);
+    EXPECT_EQ(book.process_market_order(30, hft::Side::Sell).first, 30u);
+    EXPECT_EQ(book.get_depth(), std::make_pair(size_t{0}, size_t{0}));
+}
+
+TEST_P(AuctionTest, MarketOrderRejectedDuringAuction) {
+    std::vector<std::pair<uint64_t, hft::RejectReason>> rejects;
+    hft::BasicOrderBookManager<RejectRecorder> manager(RejectRecorder{{}, &rejects});
+    auto* book = manager.get_order_book("AAPL");
+
+    manager.process_order("AAPL", 1, 101, 100, 1, hft::OrderType::Limit, hft::Side::Sell);
+    book->set_auction_mode(true);
+
+    EXPECT_FALSE(manager.process_order("AAPL", 2, 0, 40, 2, hft::OrderType::Market, hft::Side::Buy));
+    ASSERT_EQ(rejects.size(), 1u);
+    EXPECT_EQ(rejects[0].first, 2u);
+    EXPECT_EQ(rejects[0].second, hft::RejectReason::AuctionInProgress);
+
+    // Resting liquidity is untouched and the order is not kept for the uncross
+    book->add_order(3, 101, 100, 3, hft::Side::Buy);
+    EXPECT_EQ(book->uncross().volume, 100u);
+}
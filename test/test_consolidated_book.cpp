@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "consolidated_book.hpp"
+#include "order_book.hpp"
+#include "order_book_manager.hpp"
+
+using VenueBook = hft::BasicOrderBook<hft::ConsolidatedBookListener>;
+
+TEST(ConsolidatedBookTest, BestBidOfferAcrossVenues) {
+    hft::OrderPool pool(100);
+    VenueBook venue_a("AAPL", pool);
+    VenueBook venue_b("AAPL", pool);
+    hft::ConsolidatedBook nbbo(140'00);
+
+    EXPECT_EQ(nbbo.add_venue(venue_a), 0);
+    EXPECT_EQ(nbbo.add_venue(venue_b), 1);
+
+    venue_a.add_order(1, 150'00, 100, 1, hft::Side::Buy);
+    venue_b.add_order(2, 150'05, 40, 2, hft::Side::Buy);
+    venue_a.add_order(3, 150'20, 70, 3, hft::Side::Sell);
+    venue_b.add_order(4, 150'20, 30, 4, hft::Side::Sell);
+
+    auto bid = nbbo.get_best_bid();
+    EXPECT_EQ(bid.price, 150'05);
+    EXPECT_EQ(bid.quantity, 40);
+    EXPECT_EQ(bid.venue_mask, 0b10u);
+
+    auto ask = nbbo.get_best_ask();
+    EXPECT_EQ(ask.price, 150'20);
+    EXPECT_EQ(ask.quantity, 100);
+    EXPECT_EQ(ask.venue_mask, 0b11u);
+    EXPECT_EQ(nbbo.get_venue_quantity(0, hft::Side::Sell, 150'20), 70);
+
+    // Best bid moves back to venue A once venue B's level is cancelled
+    venue_b.cancel_order(2);
+    bid = nbbo.get_best_bid();
+    EXPECT_EQ(bid.price, 150'00);
+    EXPECT_EQ(bid.venue_mask, 0b01u);
+}
+
+TEST(ConsolidatedBookTest, TracksPartialFills) {
+    hft::OrderPool pool(100);
+    VenueBook venue("AAPL", pool);
+    hft::ConsolidatedBook nbbo(140'00);
+    nbbo.add_venue(venue);
+
+    venue.add_order(1, 152'00, 200, 1, hft::Side::Sell);
+    venue.add_order(2, 153'00, 100, 2, hft::Side::Sell);
+    venue.process_market_order(250, hft::Side::Buy);
+
+    auto ask = nbbo.get_best_ask();
+    EXPECT_EQ(ask.price, 153'00);
+    EXPECT_EQ(ask.quantity, 50);
+    EXPECT_EQ(nbbo.get_level(hft::Side::Sell, 152'00).quantity, 0);
+}
+
+TEST(ConsolidatedBookTest, SeedsFromManagerBookAndDetaches) {
+    hft::BasicOrderBookManager<hft::ConsolidatedBookListener> manager;
+    manager.process_order("AAPL", 1, 150'00, 100, 1, hft::OrderType::Limit, hft::Side::Buy);
+
+    {
+        hft::ConsolidatedBook nbbo(140'00);
+        EXPECT_EQ(nbbo.add_venue(manager, "AAPL"), 0);
+        EXPECT_EQ(nbbo.get_best_bid().quantity, 100);
+
+        // Unknown venues are counted, not stored
+        EXPECT_FALSE(nbbo.on_level_change(hft::MAX_VENUES, hft::Side::Buy, 150'00, 10));
+        EXPECT_EQ(nbbo.dropped_updates(), 1);
+    }
+
+    // Book keeps working after the consolidated view is gone
+    EXPECT_TRUE(manager.process_order("AAPL", 2, 151'00, 10, 2, hft::OrderType::Limit, hft::Side::Buy));
+}
+
+TEST(ConsolidatedBookTest, OffLadderLevelsStillSetBestBidOffer) {
+    hft::OrderPool pool(100);
+    VenueBook venue_a("AAPL", pool);
+    VenueBook venue_b("AAPL", pool);
+    hft::ConsolidatedBook nbbo(140'00); // Ladder covers 140.00 - 180.95
+    nbbo.add_venue(venue_a);
+    nbbo.add_venue(venue_b);
+
+    venue_a.add_order(1, 150'00, 100, 1, hft::Side::Buy);
+    venue_a.add_order(2, 150'10, 100, 2, hft::Side::Sell);
+
+    // Venue B trades through the top of the ladder on both sides
+    venue_b.add_order(3, 200'00, 30, 3, hft::Side::Buy);
+    venue_b.add_order(4, 200'50, 40, 4, hft::Side::Sell);
+    venue_b.add_order(5, 130'00, 20, 5, hft::Side::Sell); // Below base_price
+
+    EXPECT_EQ(nbbo.get_best_bid().price, 200'00);
+    EXPECT_EQ(nbbo.get_best_bid().quantity, 30);
+    EXPECT_EQ(nbbo.get_best_bid().venue_mask, 0b10u);
+    EXPECT_EQ(nbbo.get_best_ask().price, 130'00);
+    EXPECT_EQ(nbbo.get_venue_quantity(1, hft::Side::Sell, 200'50), 40);
+    EXPECT_EQ(nbbo.overflow_levels(), 3);
+    EXPECT_EQ(nbbo.dropped_updates(), 0);
+
+    // Best prices fall back to the ladder as the off-ladder levels go
+    venue_b.cancel_order(3);
+    venue_b.cancel_order(5);
+    EXPECT_EQ(nbbo.get_best_bid().price, 150'00);
+    EXPECT_EQ(nbbo.get_best_ask().price, 150'10);
+
+    EXPECT_EQ(nbbo.overflow_levels(), 1);
+}
+
+TEST(ConsolidatedBookTest, RejectsBookAlreadyAttachedElsewhere) {
+    hft::OrderPool pool(100);
+    VenueBook venue("AAPL", pool);
+    hft::ConsolidatedBook nbbo(140'00);
+    EXPECT_EQ(nbbo.add_venue(venue), 0);
+
+    {
+        hft::ConsolidatedBook other(140'00);
+        EXPECT_EQ(other.add_venue(venue), -1);
+        EXPECT_EQ(other.venue_count(), 0u);
+    }
+
+    // The rejected view going away leaves the first attachment intact
+    venue.add_order(1, 150'00, 100, 1, hft::Side::Buy);
+    EXPECT_EQ(nbbo.get_best_bid().price, 150'00u);
+    EXPECT_EQ(nbbo.add_venue(venue), -1); // Also no double attach to itself
+}
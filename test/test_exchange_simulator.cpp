@@ -0,0 +1,193 @@
+#include "gtest/gtest.h"
+#include "sim/exchange_simulator.hpp"
+#include "sim/simulation_runner.hpp"
+#include "sim/synthetic_replay.hpp"
+#include <vector>
+
+namespace {
+
+hft::ReplayEvent add(uint64_t t, uint64_t id, uint64_t price, uint32_t quantity, hft::Side side) {
+    return {t, id, price, quantity, side, hft::ReplayEventType::Add};
+}
+
+hft::ReplayEvent cancel(uint64_t t, uint64_t id) {
+    return {t, id, 0, 0, hft::Side::Buy, hft::ReplayEventType::Cancel};
+}
+
+hft::ReplayEvent execute(uint64_t t, uint32_t quantity, hft::Side aggressor) {
+    return {t, 0, 0, quantity, aggressor, hft::ReplayEventType::Execute};
+}
+
+struct RecordingStrategy : hft::NullStrategy {
+    std::vector<std::pair<uint64_t, uint64_t>> market_data; // delivered, exchange time
+    std::vector<std::pair<uint64_t, uint32_t>> fills;       // delivered, quantity
+
+    void on_market_data(hft::ExchangeSimulator& sim, const hft::SimTopOfBook& top) {
+        market_data.emplace_back(sim.now(), top.exchange_ns);
+    }
+    void on_fill(hft::ExchangeSimulator& sim, const hft::SimOrder&, uint64_t, uint32_t quantity) {
+        fills.emplace_back(sim.now(), quantity);
+    }
+};
+
+// Joins the best bid whenever it has nothing working
+struct QueueJoiner : hft::NullStrategy {
+    bool working = false;
+    uint64_t filled = 0;
+
+    void on_market_data(hft::ExchangeSimulator& sim, const hft::SimTopOfBook& top) {
+        if (!working && top.bid_price > 0) {
+            sim.send_order(hft::Side::Buy, top.bid_price, 100);
+            working = true;
+        }
+    }
+    void on_fill(hft::ExchangeSimulator&, const hft::SimOrder& order, uint64_t, uint32_t quantity) {
+        filled += quantity;
+        working = order.quantity > 0;
+    }
+    void on_reject(hft::ExchangeSimulator&, uint64_t) { working = false; }
+};
+
+} // namespace
+
+TEST(ExchangeSimulatorTest, TracksVolumeAhead) {
+    hft::LatencyModel latency;
+    latency.order_entry_ns = 50;
+    hft::ExchangeSimulator sim("AAPL", latency);
+    RecordingStrategy strategy;
+
+    std::vector<hft::ReplayEvent> before{
+        add(10, 1, 99'00, 300, hft::Side::Buy),
+        add(20, 2, 99'00, 200, hft::Side::Buy),
+    };
+    sim.run(before.data(), before.size(), strategy);
+
+    // Sent at t=20, rests at t=70 behind 500
+    uint64_t id = sim.send_order(hft::Side::Buy, 99'00, 100);
+    std::vector<hft::ReplayEvent> after{
+        add(100, 3, 99'00, 100, hft::Side::Buy), // Behind us
+        cancel(200, 2),
+        execute(300, 100, hft::Side::Sell),
+        cancel(400, 3),
+    };
+    sim.run(after.data(), after.size(), strategy);
+    EXPECT_TRUE(sim.order(id).live);
+    EXPECT_EQ(sim.order(id).volume_ahead, 200u);
+
+    std::vector<hft::ReplayEvent> fill{execute(500, 250, hft::Side::Sell)};
+    sim.run(fill.data(), fill.size(), strategy);
+    EXPECT_EQ(sim.order(id).volume_ahead, 0u);
+    EXPECT_EQ(sim.order(id).filled, 50u);
+    EXPECT_EQ(sim.order(id).quantity, 50u);
+
+    // The fill is reported one order-entry delay later
+    ASSERT_EQ(strategy.fills.size(), 1u);
+    EXPECT_EQ(strategy.fills[0], std::make_pair(uint64_t{550}, uint32_t{50}));
+}
+
+TEST(ExchangeSimulatorTest, DelaysMarketData) {
+    hft::LatencyModel latency;
+    latency.market_data_ns = 1000;
+    latency.jitter_ns = 100;
+    hft::ExchangeSimulator sim("AAPL", latency, 7);
+    RecordingStrategy strategy;
+
+    std::vector<hft::ReplayEvent> events;
+    for (uint64_t i = 0; i < 50; ++i) {
+        events.push_back(add(i * 10, i + 1, 99'00 + i, 100, hft::Side::Buy));
+    }
+    sim.run(events.data(), events.size(), strategy);
+
+    ASSERT_EQ(strategy.market_data.size(), 50u);
+    uint64_t last = 0;
+    for (const auto& [delivered, exchange] : strategy.market_data) {
+        EXPECT_GE(delivered, exchange + 1000);
+        EXPECT_GE(delivered, last); // Never reordered
+        last = delivered;
+    }
+}
+
+TEST(ExchangeSimulatorTest, ParallelRunsMatchSerial) {
+    std::vector<hft::SymbolReplay> replays;
+    for (uint64_t s = 0; s < 6; ++s) {
+        replays.push_back({"SYM" + std::to_string(s), hft::generate_synthetic_replay(s + 1, 20000)});
+    }
+
+    hft::LatencyModel latency{2000, 1000, 500};
+    std::vector<QueueJoiner> serial(replays.size()), parallel(replays.size());
+    auto serial_stats = hft::simulate_symbols(replays, serial, latency, 1);
+    auto parallel_stats = hft::simulate_symbols(replays, parallel, latency, 4);
+
+    uint64_t filled = 0;
+    for (size_t i = 0; i < replays.size(); ++i) {
+        EXPECT_EQ(serial_stats[i].replay_events, 20000u);
+        EXPECT_EQ(serial_stats[i].own_orders, parallel_stats[i].own_orders);
+        EXPECT_EQ(serial_stats[i].own_filled_quantity, parallel_stats[i].own_filled_quantity);
+        EXPECT_EQ(serial[i].filled, parallel[i].filled);
+        filled += serial[i].filled;
+    }
+    EXPECT_GT(filled, 0u);
+}
+
+TEST(ExchangeSimulatorTest, MarketableOrderFillsAtRestingPrices) {
+    struct FillPrices : hft::NullStrategy {
+        std::vector<std::pair<uint64_t, uint32_t>> fills; // price, quantity
+        void on_fill(hft::ExchangeSimulator&, const hft::SimOrder&, uint64_t price, uint32_t quantity) {
+            fills.emplace_back(price, quantity);
+        }
+    };
+
+    hft::ExchangeSimulator sim("AAPL");
+    FillPrices strategy;
+    std::vector<hft::ReplayEvent> book{
+        add(10, 1, 99'00, 100, hft::Side::Buy),
+        add(20, 2, 101'00, 100, hft::Side::Sell),
+        add(30, 3, 101'50, 100, hft::Side::Sell),
+    };
+    sim.run(book.data(), book.size(), strategy);
+
+    // Lifts both offers through its 102.00 limit, never at the mid
+    sim.send_order(hft::Side::Buy, 102'00, 150);
+    sim.run(nullptr, 0, strategy);
+
+    ASSERT_EQ(strategy.fills.size(), 2u);
+    EXPECT_EQ(strategy.fills[0], std::make_pair(uint64_t{101'00}, uint32_t{100}));
+    EXPECT_EQ(strategy.fills[1], std::make_pair(uint64_t{101'50}, uint32_t{50}));
+    EXPECT_EQ(sim.book().get_best_ask(), 101'50u);
+
+    // Recorded flow crossing our resting bid trades at our price
+    uint64_t bid = sim.send_order(hft::Side::Buy, 100'00, 50);
+    sim.run(nullptr, 0, strategy);
+    std::vector<hft::ReplayEvent> cross{add(100, 4, 99'50, 50, hft::Side::Sell)};
+    sim.run(cross.data(), cross.size(), strategy);
+
+    ASSERT_EQ(strategy.fills.size(), 3u);
+    EXPECT_EQ(strategy.fills[2], std::make_pair(uint64_t{100'00}, uint32_t{50}));
+    EXPECT_EQ(sim.order(bid).quantity, 0u);
+}
+
+TEST(ExchangeSimulatorTest, RejectsCancelOfUnknownOrder) {
+    struct Rejects : hft::NullStrategy {
+        std::vector<uint64_t> rejected;
+        std::vector<uint64_t> cancelled;
+        void on_reject(hft::ExchangeSimulator&, uint64_t order_id) { rejected.push_back(order_id); }
+        void on_cancel(hft::ExchangeSimulator&, uint64_t order_id) { cancelled.push_back(order_id); }
+    };
+
+    hft::ExchangeSimulator sim("AAPL");
+    Rejects strategy;
+    uint64_t bid = sim.send_order(hft::Side::Buy, 100'00, 50);
+    sim.run(nullptr, 0, strategy);
+
+    // Never handed out, a recorded id, then ours twice
+    uint64_t unknown = hft::SIM_OWN_ORDER_BIT | 1000;
+    sim.cancel_order(unknown);
+    sim.cancel_order(7);
+    sim.cancel_order(bid);
+    sim.cancel_order(bid);
+    sim.run(nullptr, 0, strategy);
+
+    EXPECT_EQ(strategy.cancelled, std::vector<uint64_t>{bid});
+    EXPECT_EQ(strategy.rejected, (std::vector<uint64_t>{unknown, 7, bid}));
+    EXPECT_EQ(sim.book().get_best_bid(), 0u);
+}
@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+#include "fix/fix_decoder.hpp"
+#include "fix/fix_order_entry.hpp"
+#include "order_book_manager.hpp"
+#include <string>
+
+namespace {
+
+// Wrap body fields ("35=D|11=1|...|", '|' for SOH) in a valid header/trailer
+std::string fix_message(std::string body, int checksum_delta = 0) {
+    for (auto& c : body) {
+        if (c == '|') c = hft::FIX_SOH;
+    }
+    std::string message = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+
+    unsigned sum = 0;
+    for (unsigned char c : message) sum += c;
+    char trailer[8];
+    snprintf(trailer, sizeof(trailer), "10=%03u\x01", (sum + checksum_delta) % 256);
+    return message + trailer;
+}
+
+hft::FixStatus decode(const std::string& message, hft::FixOrder& order, size_t& consumed) {
+    return hft::decode_fix(message.data(), message.size(), order, consumed);
+}
+
+} // namespace
+
+TEST(FixDecoderTest, NewOrderSingle) {
+    // Padding fields push the order fields across the 64-byte scan blocks
+    std::string message = fix_message(
+        "35=D|49=CLIENT|56=ENGINE|34=12|52=20240102-09:30:00.123|"
+        "11=1001|55=AAPL|54=2|60=20240102-09:30:00.123|38=250|40=2|44=150.25|58=a=b|");
+    hft::FixOrder order;
+    size_t consumed = 0;
+
+    ASSERT_EQ(decode(message, order, consumed), hft::FixStatus::Ok);
+    EXPECT_EQ(consumed, message.size());
+    EXPECT_EQ(order.type, hft::FixMsgType::NewOrderSingle);
+    EXPECT_EQ(order.cl_ord_id, 1001u);
+    EXPECT_EQ(order.symbol, "AAPL");
+    EXPECT_EQ(order.side, hft::Side::Sell);
+    EXPECT_EQ(order.ord_type, hft::OrderType::Limit);
+    EXPECT_EQ(order.price, 150'25u);
+    EXPECT_EQ(order.quantity, 250u);
+}
+
+TEST(FixDecoderTest, PriceConversion) {
+    hft::FixOrder order;
+    size_t consumed = 0;
+    auto price = [&](const std::string& text) {
+        auto status = decode(fix_message("35=D|11=1|55=X|54=1|38=1|40=2|44=" + text + "|"), order, consumed);
+        return status == hft::FixStatus::Ok ? order.price : ~0ull;
+    };
+
+    EXPECT_EQ(price("150"), 150'00u);
+    EXPECT_EQ(price("150.5"), 150'50u);
+    EXPECT_EQ(price("150.50000"), 150'50u);
+    EXPECT_EQ(price("0.01"), 1u);
+    EXPECT_EQ(price("150.505"), ~0ull); // Off tick
+    EXPECT_EQ(price("15O.00"), ~0ull);
+    EXPECT_EQ(price(""), ~0ull);
+}
+
+TEST(FixDecoderTest, RejectsBadFraming) {
+    hft::FixOrder order;
+    size_t consumed = 0;
+    std::string good = fix_message("35=D|11=1|55=AAPL|54=1|38=10|40=2|44=1|");
+
+    EXPECT_EQ(decode(fix_message("35=D|11=1|55=AAPL|54=1|38=10|40=2|44=1|", 1), order, consumed),
+              hft::FixStatus::BadChecksum);
+    EXPECT_EQ(consumed, good.size());
+
+    // Incomplete until the CheckSum field is terminated
+    EXPECT_EQ(hft::decode_fix(good.data(), good.size() - 1, order, consumed), hft::FixStatus::Incomplete);
+    EXPECT_EQ(consumed, 0u);
+
+    // Missing Side, non-numeric ClOrdID, market orders need no price
+    EXPECT_EQ(decode(fix_message("35=D|11=1|55=AAPL|38=10|40=2|44=1|"), order, consumed),
+              hft::FixStatus::Malformed);
+    EXPECT_EQ(decode(fix_message("35=D|11=A1|55=AAPL|54=1|38=10|40=2|44=1|"), order, consumed),
+              hft::FixStatus::Malformed);
+    EXPECT_EQ(decode(fix_message("35=D|11=1|55=AAPL|54=1|38=10|40=1|"), order, consumed),
+              hft::FixStatus::Ok);
+
+    // Heartbeat is well formed but not an order
+    EXPECT_EQ(decode(fix_message("35=0|"), order, consumed), hft::FixStatus::Unsupported);
+}
+
+TEST(FixDecoderTest, OrderEntryFeedsManager) {
+    hft::OrderBookManager manager;
+    hft::FixOrderEntry<hft::OrderBookManager> entry(manager);
+
+    std::string stream =
+        fix_message("35=D|11=1|55=AAPL|54=1|38=100|40=2|44=150.00|") +
+        fix_message("35=D|11=2|55=AAPL|54=1|38=100|40=2|44=149.00|") +
+        fix_message("35=F|11=3|41=1|55=AAPL|54=1|") +
+        fix_message("35=G|11=4|41=2|55=AAPL|54=1|38=50|40=2|44=149.50|") +
+        fix_message("35=D|11=5|55=AAPL|54=1|38=1|40=2|44=1|", 7) +
+        fix_message("35=0|");
+
+    // Deliver in two pieces, splitting a message in the middle
+    size_t split = stream.size() / 2;
+    size_t used = entry.on_data(stream.data(), split);
+    std::string rest = stream.substr(used);
+    EXPECT_EQ(entry.on_data(rest.data(), rest.size()), rest.size());
+
+    EXPECT_EQ(entry.messages(), 6u);
+    EXPECT_EQ(entry.invalid_messages(), 1u);
+    EXPECT_EQ(entry.rejected_orders(), 0u);
+
+    auto* book = manager.get_order_book("AAPL");
+    EXPECT_EQ(book->get_best_bid(), 149'50u);
+    EXPECT_EQ(book->get_depth(), std::make_pair(size_t{1}, size_t{0}));
+
+    // The replaced order is gone, its replacement can be cancelled
+    std::string cancels = fix_message("35=F|11=6|41=2|55=AAPL|54=1|") +
+                          fix_message("35=F|11=7|41=4|55=AAPL|54=1|");
+    entry.on_data(cancels.data(), cancels.size());
+    EXPECT_EQ(entry.rejected_orders(), 1u);
+    EXPECT_EQ(book->get_depth(), std::make_pair(size_t{0}, size_t{0}));
+}
+
+TEST(FixDecoderTest, ReplaceAfterPartialFill) {
+    hft::OrderBookManager manager;
+    hft::FixOrderEntry<hft::OrderBookManager> entry(manager);
+    auto* book = manager.get_order_book("AAPL");
+
+    std::string stream = fix_message("35=D|11=1|55=AAPL|54=1|38=100|40=2|44=150.00|");
+    entry.on_data(stream.data(), stream.size());
+    EXPECT_TRUE(manager.process_order("AAPL", 90, 0, 40, 90, hft::OrderType::Market, hft::Side::Sell));
+
+    // OrderQty is the new total: 80 less the 40 done leaves 40
+    stream = fix_message("35=G|11=2|41=1|55=AAPL|54=1|38=80|40=2|44=150.00|");
+    entry.on_data(stream.data(), stream.size());
+    EXPECT_EQ(book->get_order_quantity(1), 0u);
+    EXPECT_EQ(book->get_order_quantity(2), 40u);
+
+    // Executed quantity carries across the replace chain
+    EXPECT_TRUE(manager.process_order("AAPL", 91, 0, 10, 91, hft::OrderType::Market, hft::Side::Sell));
+    stream = fix_message("35=G|11=3|41=2|55=AAPL|54=1|38=100|40=2|44=150.00|");
+    entry.on_data(stream.data(), stream.size());
+    EXPECT_EQ(book->get_order_quantity(3), 50u);
+
+    // Nothing would be left: rejected, the working order is untouched
+    stream = fix_message("35=G|11=4|41=3|55=AAPL|54=1|38=50|40=2|44=150.00|");
+    entry.on_data(stream.data(), stream.size());
+    EXPECT_EQ(entry.rejected_orders(), 1u);
+    EXPECT_EQ(book->get_order_quantity(3), 50u);
+    EXPECT_EQ(book->get_order_quantity(4), 0u);
+}
@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include "market_data/md_consumer.hpp"
+#include "market_data/md_publisher.hpp"
+#include "order_book.hpp"
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+std::string ring_name(const char* tag) {
+    return std::string("/hft_md_test_") + tag + "_" + std::to_string(getpid());
+}
+
+} // namespace
+
+TEST(MarketDataTest, PublishesBookUpdates) {
+    std::string name = ring_name("book");
+    hft::MarketDataPublisher publisher;
+    ASSERT_TRUE(publisher.open(name, 64));
+
+    hft::MarketDataConsumer consumer;
+    ASSERT_TRUE(consumer.open(name));
+
+    hft::OrderPool pool(100);
+    hft::BasicOrderBook<hft::MarketDataListener> book("AAPL", pool, {{}, &publisher});
+    book.add_order(1, 150'00, 100, 1, hft::Side::Buy);
+    book.add_order(2, 149'00, 50, 2, hft::Side::Buy); // Below the best bid
+
+    hft::MarketDataUpdate update;
+    ASSERT_EQ(consumer.poll(update), hft::PollResult::Update);
+    EXPECT_EQ(update.type, hft::UpdateType::Level);
+    EXPECT_EQ(std::string(update.symbol), "AAPL");
+    EXPECT_EQ(update.bid_price, 150'00u);
+    EXPECT_EQ(update.bid_quantity, 100u);
+
+    ASSERT_EQ(consumer.poll(update), hft::PollResult::Update);
+    EXPECT_EQ(update.type, hft::UpdateType::TopOfBook);
+    EXPECT_EQ(update.bid_price, 150'00u);
+    EXPECT_EQ(update.ask_quantity, 0u);
+
+    // A level behind the best bid does not move the top of book
+    ASSERT_EQ(consumer.poll(update), hft::PollResult::Update);
+    EXPECT_EQ(update.type, hft::UpdateType::Level);
+    EXPECT_EQ(update.bid_price, 149'00u);
+    EXPECT_EQ(consumer.poll(update), hft::PollResult::Empty);
+}
+
+TEST(MarketDataTest, ConsumerDetectsOverrun) {
+    std::string name = ring_name("overrun");
+    hft::MarketDataPublisher publisher;
+    ASSERT_TRUE(publisher.open(name, 8));
+
+    hft::MarketDataConsumer consumer;
+    ASSERT_TRUE(consumer.open(name));
+
+    for (uint64_t i = 0; i < 20; ++i) {
+        publisher.publish_level("AAPL", hft::Side::Sell, 100'00 + i, 1);
+    }
+
+    hft::MarketDataUpdate update;
+    EXPECT_EQ(consumer.poll(update), hft::PollResult::Overrun);
+    EXPECT_EQ(consumer.lost_updates(), 12u);
+
+    // Resumes at the oldest retained update
+    ASSERT_EQ(consumer.poll(update), hft::PollResult::Update);
+    EXPECT_EQ(update.ask_price, 100'12u);
+}
+
+#ifndef NDEBUG
+TEST(MarketDataDeathTest, SecondProducerThreadAsserts) {
+    std::string name = ring_name("owner");
+    hft::MarketDataPublisher publisher;
+    ASSERT_TRUE(publisher.open(name, 64));
+    publisher.publish_level("AAPL", hft::Side::Buy, 150'00, 100);
+
+    EXPECT_DEATH({
+        std::thread other([&] { publisher.publish_level("MSFT", hft::Side::Buy, 300'00, 10); });
+        other.join();
+    }, "single producer thread");
+}
+#endif
@@ -17,3 +17,51 @@ TEST(OrderBookTest, CancelOrder) {
     EXPECT_TRUE(book.cancel_order(1));
     EXPECT_FALSE(book.cancel_order(2)); // Non-existent order
 }
+
+TEST(OrderBookTest, CancelKeepsTimePriority) {
+    hft::OrderPool pool(100);
+    hft::OrderBook book("AAPL", pool);
+
+    book.add_order(1, 100'00, 10, 1, hft::Side::Buy);
+    book.add_order(2, 100'00, 10, 2, hft::Side::Buy);
+    book.add_order(3, 100'00, 10, 3, hft::Side::Buy);
+    book.add_order(4, 100'00, 10, 4, hft::Side::Buy);
+    book.cancel_order(2);
+
+    // Fills 1 then 3; 4 is still first in line behind them
+    book.process_market_order(20, hft::Side::Sell);
+    EXPECT_FALSE(book.cancel_order(3));
+    EXPECT_TRUE(book.cancel_order(4));
+}
+
+TEST(OrderBookTest, RejectsLevelBeyondCapacity) {
+    hft::OrderPool pool(hft::MAX_PRICE_LEVELS + 10);
+    hft::OrderBook book("AAPL", pool);
+
+    for (uint64_t i = 0; i < hft::MAX_PRICE_LEVELS; ++i) {
+        ASSERT_TRUE(book.add_order(i + 1, 100'00 - i, 10, 1, hft::Side::Buy));
+    }
+
+    // A new price once the level array is full is refused, an existing one is not
+    EXPECT_FALSE(book.add_order(5000, 50'00, 10, 1, hft::Side::Buy));
+    EXPECT_TRUE(book.add_order(5001, 100'00, 10, 1, hft::Side::Buy));
+    EXPECT_EQ(book.get_depth().first, hft::MAX_PRICE_LEVELS);
+    EXPECT_EQ(book.get_best_bid(), 100'00u);
+}
+
+TEST(OrderBookTest, PricesSnapshot) {
+    hft::OrderPool pool(100);
+    hft::OrderBook book("AAPL", pool);
+
+    auto empty = book.get_prices();
+    EXPECT_EQ(empty.reference, 0u);
+    EXPECT_EQ(empty.best_bid, 0u);
+    EXPECT_EQ(empty.best_ask, std::numeric_limits<uint64_t>::max());
+
+    book.add_order(1, 99'00, 10, 1, hft::Side::Buy);
+    book.add_order(2, 101'00, 10, 2, hft::Side::Sell);
+    auto prices = book.get_prices();
+    EXPECT_EQ(prices.best_bid, 99'00u);
+    EXPECT_EQ(prices.best_ask, 101'00u);
+    EXPECT_EQ(prices.reference, book.get_reference_price());
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+#include "order_book.hpp"
+#include "order_book_manager.hpp"
+#include <vector>
+
+namespace {
+
+// Records every event it sees; unused hooks fall back to the no-op base
+struct RecordingListener : hft::NullOrderBookListener {
+    std::vector<uint64_t>* accepted;
+    std::vector<uint64_t>* cancelled;
+    std::vector<hft::RejectReason>* rejected;
+    std::vector<std::pair<uint64_t, uint32_t>>* fills;
+    uint64_t* traded;
+
+    void on_accept(const hft::Order& order) { accepted->push_back(order.id); }
+    void on_cancel(const hft::Order& order) { cancelled->push_back(order.id); }
+    void on_reject(uint64_t, hft::RejectReason reason) { rejected->push_back(reason); }
+    void on_fill(const hft::Order& order, uint64_t, uint32_t quantity) {
+        fills->emplace_back(order.id, quantity);
+    }
+    void on_trade(std::string_view, uint64_t, uint32_t quantity, hft::Side) {
+        *traded += quantity;
+    }
+};
+
+} // namespace
+
+TEST(OrderBookListenerTest, ReportsBookEvents) {
+    std::vector<uint64_t> accepted, cancelled;
+    std::vector<hft::RejectReason> rejected;
+    std::vector<std::pair<uint64_t, uint32_t>> fills;
+    uint64_t traded = 0;
+
+    hft::OrderPool pool(100);
+    hft::BasicOrderBook<RecordingListener> book(
+        "AAPL", pool, {{}, &accepted, &cancelled, &rejected, &fills, &traded});
+
+    EXPECT_TRUE(book.add_order(1, 152'00, 100, 1, hft::Side::Sell));
+    EXPECT_TRUE(book.add_order(2, 153'00, 100, 2, hft::Side::Sell));
+    EXPECT_FALSE(book.add_order(1, 152'00, 100, 3, hft::Side::Sell));
+    EXPECT_TRUE(book.cancel_order(2));
+    EXPECT_FALSE(book.cancel_order(42));
+    book.process_market_order(60, hft::Side::Buy);
+
+    EXPECT_EQ(accepted, (std::vector<uint64_t>{1, 2}));
+    EXPECT_EQ(cancelled, (std::vector<uint64_t>{2}));
+    ASSERT_EQ(rejected.size(), 2u);
+    EXPECT_EQ(rejected[0], hft::RejectReason::DuplicateOrderId);
+    EXPECT_EQ(rejected[1], hft::RejectReason::UnknownOrder);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_EQ(fills[0], std::make_pair(uint64_t{1}, uint32_t{60}));
+    EXPECT_EQ(traded, 60u);
+}
+
+TEST(OrderBookListenerTest, ManagerSharesListenerAcrossBooks) {
+    std::vector<uint64_t> accepted, cancelled;
+    std::vector<hft::RejectReason> rejected;
+    std::vector<std::pair<uint64_t, uint32_t>> fills;
+    uint64_t traded = 0;
+
+    hft::BasicOrderBookManager<RecordingListener> manager(
+        {{}, &accepted, &cancelled, &rejected, &fills, &traded});
+
+    manager.process_order("AAPL", 1, 150'00, 10, 1, hft::OrderType::Limit, hft::Side::Buy);
+    manager.process_order("MSFT", 2, 300'00, 10, 2, hft::OrderType::Limit, hft::Side::Buy);
+
+    EXPECT_EQ(accepted, (std::vector<uint64_t>{1, 2}));
+}
@@ -0,0 +1,244 @@
+#include "gtest/gtest.h"
+#include "gateway/order_gateway.hpp"
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+int connect_unix(const std::string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void send_order(int fd, hft::MessageType type, hft::OrderType order_type, hft::Side side,
+                uint64_t id, uint64_t price, uint32_t quantity) {
+    hft::OrderMessage msg{};
+    msg.type = type;
+    msg.order_type = order_type;
+    msg.side = side;
+    msg.client_order_id = id;
+    msg.price = price;
+    msg.quantity = quantity;
+    msg.client_timestamp = id;
+    std::memcpy(msg.symbol, "AAPL", 4);
+    ASSERT_EQ(send(fd, &msg, sizeof(msg), 0), static_cast<ssize_t>(sizeof(msg)));
+}
+
+hft::ResponseMessage read_response(int fd) {
+    hft::ResponseMessage resp{};
+    size_t got = 0;
+    while (got < sizeof(resp)) {
+        ssize_t n = recv(fd, reinterpret_cast<char*>(&resp) + got, sizeof(resp) - got, 0);
+        if (n <= 0) {
+            break;
+        }
+        got += static_cast<size_t>(n);
+    }
+    return resp;
+}
+
+} // namespace
+
+TEST(OrderGatewayTest, AcksFillsAndCancels) {
+    hft::GatewayConfig config;
+    config.unix_path = "/tmp/hft_gateway_test_" + std::to_string(getpid()) + ".sock";
+
+    auto gateway = std::make_unique<hft::OrderGateway>(config);
+    ASSERT_TRUE(gateway->start());
+    std::thread loop([&] { gateway->run(); });
+
+    int maker = connect_unix(config.unix_path);
+    int taker = connect_unix(config.unix_path);
+    ASSERT_GE(maker, 0);
+    ASSERT_GE(taker, 0);
+
+    send_order(maker, hft::MessageType::NewOrder, hft::OrderType::Limit, hft::Side::Sell, 1, 101'00, 100);
+    auto ack = read_response(maker);
+    EXPECT_EQ(ack.type, hft::ResponseType::Ack);
+    EXPECT_EQ(ack.client_order_id, 1u);
+
+    // Same client id on another session does not collide
+    send_order(taker, hft::MessageType::NewOrder, hft::OrderType::Market, hft::Side::Buy, 1, 0, 40);
+    auto taker_fill = read_response(taker);
+    EXPECT_EQ(taker_fill.type, hft::ResponseType::Fill);
+    EXPECT_EQ(taker_fill.quantity, 40u);
+    EXPECT_EQ(taker_fill.price, 101'00u);
+
+    auto maker_fill = read_response(maker);
+    EXPECT_EQ(maker_fill.type, hft::ResponseType::Fill);
+    EXPECT_EQ(maker_fill.client_order_id, 1u);
+    EXPECT_EQ(maker_fill.quantity, 40u);
+    EXPECT_EQ(maker_fill.client_timestamp, 0u);
+
+    // Side byte outside the enum never reaches the book
+    send_order(maker, hft::MessageType::NewOrder, hft::OrderType::Limit, static_cast<hft::Side>(7), 2, 101'00, 10);
+    auto bad_side = read_response(maker);
+    EXPECT_EQ(bad_side.type, hft::ResponseType::Reject);
+    EXPECT_EQ(bad_side.reason, hft::RejectReason::InvalidMessage);
+    EXPECT_EQ(gateway->manager().get_order_book("AAPL")->get_best_bid(), 0u);
+
+    send_order(maker, hft::MessageType::CancelOrder, hft::OrderType::Limit, hft::Side::Sell, 1, 0, 0);
+    EXPECT_EQ(read_response(maker).type, hft::ResponseType::Cancelled);
+
+    send_order(maker, hft::MessageType::CancelOrder, hft::OrderType::Limit, hft::Side::Sell, 1, 0, 0);
+    auto reject = read_response(maker);
+    EXPECT_EQ(reject.type, hft::ResponseType::Reject);
+    EXPECT_EQ(reject.reason, hft::RejectReason::UnknownOrder);
+
+    close(maker);
+    close(taker);
+    gateway->stop();
+    loop.join();
+}
+
+TEST(OrderGatewayTest, CrossingLimitOrderFillsBothSessions) {
+    hft::GatewayConfig config;
+    config.unix_path = "/tmp/hft_gateway_cross_" + std::to_string(getpid()) + ".sock";
+
+    auto gateway = std::make_unique<hft::OrderGateway>(config);
+    ASSERT_TRUE(gateway->start());
+    std::thread loop([&] { gateway->run(); });
+
+    int maker = connect_unix(config.unix_path);
+    int taker = connect_unix(config.unix_path);
+    ASSERT_GE(maker, 0);
+    ASSERT_GE(taker, 0);
+
+    send_order(maker, hft::MessageType::NewOrder, hft::OrderType::Limit, hft::Side::Sell, 1, 101'00, 100);
+    EXPECT_EQ(read_response(maker).type, hft::ResponseType::Ack);
+
+    // Bid through the offer: acked, then filled at the resting price
+    send_order(taker, hft::MessageType::NewOrder, hft::OrderType::Limit, hft::Side::Buy, 7, 102'00, 40);
+    EXPECT_EQ(read_response(taker).type, hft::ResponseType::Ack);
+    auto taker_fill = read_response(taker);
+    EXPECT_EQ(taker_fill.type, hft::ResponseType::Fill);
+    EXPECT_EQ(taker_fill.client_order_id, 7u);
+    EXPECT_EQ(taker_fill.quantity, 40u);
+    EXPECT_EQ(taker_fill.price, 101'00u);
+
+    auto maker_fill = read_response(maker);
+    EXPECT_EQ(maker_fill.type, hft::ResponseType::Fill);
+    EXPECT_EQ(maker_fill.client_order_id, 1u);
+    EXPECT_EQ(maker_fill.quantity, 40u);
+    EXPECT_EQ(maker_fill.price, 101'00u);
+
+    close(maker);
+    close(taker);
+    gateway->stop();
+    loop.join();
+
+    // Nothing left crossed
+    auto* book = gateway->manager().get_order_book("AAPL");
+    EXPECT_LT(book->get_best_bid(), book->get_best_ask());
+}
+
+TEST(OrderGatewayTest, DisconnectCancelsRestingOrders) {
+    hft::GatewayConfig config;
+    config.unix_path = "/tmp/hft_gateway_disconnect_" + std::to_string(getpid()) + ".sock";
+
+    auto gateway = std::make_unique<hft::OrderGateway>(config);
+    ASSERT_TRUE(gateway->start());
+    std::thread loop([&] { gateway->run(); });
+
+    int maker = connect_unix(config.unix_path);
+    int taker = connect_unix(config.unix_path);
+    ASSERT_GE(maker, 0);
+    ASSERT_GE(taker, 0);
+
+    send_order(maker, hft::MessageType::NewOrder, hft::OrderType::Limit, hft::Side::Sell, 1, 101'00, 100);
+    EXPECT_EQ(read_response(maker).type, hft::ResponseType::Ack);
+    send_order(maker, hft::MessageType::NewOrder, hft::OrderType::Limit, hft::Side::Sell, 2, 102'00, 50);
+    EXPECT_EQ(read_response(maker).type, hft::ResponseType::Ack);
+
+    // Partially fill the first order, then drop the maker
+    send_order(taker, hft::MessageType::NewOrder, hft::OrderType::Market, hft::Side::Buy, 1, 0, 40);
+    EXPECT_EQ(read_response(taker).type, hft::ResponseType::Fill);
+    EXPECT_EQ(read_response(maker).type, hft::ResponseType::Fill);
+
+    auto* book = gateway->manager().get_order_book("AAPL");
+    close(maker);
+
+    for (int i = 0; i < 1000 && book->get_best_ask() != std::numeric_limits<uint64_t>::max(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(book->get_best_ask(), std::numeric_limits<uint64_t>::max());
+
+    // Nothing left for the taker to hit
+    send_order(taker, hft::MessageType::NewOrder, hft::OrderType::Market, hft::Side::Buy, 2, 0, 10);
+    auto reject = read_response(taker);
+    EXPECT_EQ(reject.type, hft::ResponseType::Reject);
+    EXPECT_EQ(reject.reason, hft::RejectReason::NoLiquidity);
+
+    // The freed slot is usable again
+    int again = connect_unix(config.unix_path);
+    ASSERT_GE(again, 0);
+    send_order(again, hft::MessageType::NewOrder, hft::OrderType::Limit, hft::Side::Sell, 1, 101'00, 10);
+    EXPECT_EQ(read_response(again).type, hft::ResponseType::Ack);
+    EXPECT_EQ(book->get_best_ask(), 101'00u);
+
+    close(again);
+    close(taker);
+    gateway->stop();
+    loop.join();
+}
+
+TEST(OrderGatewayTest, SlowSessionKeepsEveryFill) {
+    hft::GatewayConfig config;
+    config.unix_path = "/tmp/hft_gateway_slow_" + std::to_string(getpid()) + ".sock";
+
+    auto gateway = std::make_unique<hft::OrderGateway>(config);
+    ASSERT_TRUE(gateway->start());
+    std::thread loop([&] { gateway->run(); });
+
+    int maker = connect_unix(config.unix_path);
+    int taker = connect_unix(config.unix_path);
+    ASSERT_GE(maker, 0);
+    ASSERT_GE(taker, 0);
+
+    constexpr uint32_t FILLS = 40'000;
+    send_order(maker, hft::MessageType::NewOrder, hft::OrderType::Limit, hft::Side::Sell, 1, 101'00, FILLS);
+    EXPECT_EQ(read_response(maker).type, hft::ResponseType::Ack);
+
+    // A lost fill shows up as a read timeout instead of a hang
+    timeval timeout{2, 0};
+    setsockopt(maker, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // The maker stops reading while each taker order produces a maker fill:
+    // far more than its gateway buffer and socket buffer can hold
+    uint32_t taker_fills = 0;
+    for (uint32_t i = 0; i < FILLS; ++i) {
+        send_order(taker, hft::MessageType::NewOrder, hft::OrderType::Market, hft::Side::Buy, i + 1, 0, 1);
+        taker_fills += read_response(taker).type == hft::ResponseType::Fill;
+    }
+    EXPECT_EQ(taker_fills, FILLS);
+
+    uint64_t filled = 0;
+    for (uint32_t i = 0; i < FILLS; ++i) {
+        auto fill = read_response(maker);
+        if (fill.type != hft::ResponseType::Fill || fill.client_order_id != 1) {
+            break;
+        }
+        filled += fill.quantity;
+    }
+    EXPECT_EQ(filled, FILLS);
+
+    close(maker);
+    close(taker);
+    gateway->stop();
+    loop.join();
+    EXPECT_GT(gateway->backlogged_responses(), 0u);
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "order_book_manager.hpp"
+#include "pre_trade_risk.hpp"
+
+using RiskManager = hft::BasicOrderBookManager<hft::NullOrderBookListener, hft::PreTradeRisk>;
+
+TEST(PreTradeRiskTest, MaxOrderQuantity) {
+    RiskManager manager;
+    hft::RiskLimits limits;
+    limits.max_order_quantity = 100;
+    manager.risk().set_limits(7, limits);
+
+    EXPECT_TRUE(manager.process_order("AAPL", 1, 150'00, 100, 1, hft::OrderType::Limit, hft::Side::Buy, 7));
+    EXPECT_FALSE(manager.process_order("AAPL", 2, 150'00, 101, 2, hft::OrderType::Limit, hft::Side::Buy, 7));
+    // Other accounts keep the default (unlimited) limits
+    EXPECT_TRUE(manager.process_order("AAPL", 3, 150'00, 101, 3, hft::OrderType::Limit, hft::Side::Buy, 8));
+    EXPECT_FALSE(manager.process_order("AAPL", 4, 150'00, 1, 4, hft::OrderType::Limit, hft::Side::Buy, hft::MAX_ACCOUNTS));
+}
+
+TEST(PreTradeRiskTest, PriceBandAgainstMid) {
+    RiskManager manager;
+    hft::RiskLimits limits;
+    limits.price_band_bps = 100; // 1%
+    manager.risk().set_default_limits(limits);
+
+    manager.process_order("AAPL", 1, 99'00, 10, 1, hft::OrderType::Limit, hft::Side::Buy);
+    manager.process_order("AAPL", 2, 101'00, 10, 2, hft::OrderType::Limit, hft::Side::Sell);
+
+    EXPECT_TRUE(manager.process_order("AAPL", 3, 100'50, 10, 3, hft::OrderType::Limit, hft::Side::Buy));
+    EXPECT_FALSE(manager.process_order("AAPL", 4, 102'00, 10, 4, hft::OrderType::Limit, hft::Side::Sell));
+}
+
+TEST(PreTradeRiskTest, PositionTracksFillsAndCancels) {
+    RiskManager manager;
+    hft::RiskLimits limits;
+    limits.max_position = 100;
+    manager.risk().set_limits(1, limits);
+
+    // Resting buy counts against the limit while open
+    EXPECT_TRUE(manager.process_order("AAPL", 1, 100'00, 80, 1, hft::OrderType::Limit, hft::Side::Buy, 1));
+    EXPECT_FALSE(manager.process_order("AAPL", 2, 100'00, 30, 2, hft::OrderType::Limit, hft::Side::Buy, 1));
+    EXPECT_EQ(manager.risk().open_notional(1), 80 * 100'00u);
+
+    // Account 2 hits the bid: account 1 is now long 50 with 30 still open
+    EXPECT_TRUE(manager.process_order("AAPL", 3, 0, 50, 3, hft::OrderType::Market, hft::Side::Sell, 2));
+    EXPECT_EQ(manager.risk().position(1), 50);
+    EXPECT_EQ(manager.risk().position(2), -50);
+    EXPECT_EQ(manager.risk().open_quantity(1, hft::Side::Buy), 30u);
+
+    // Cancelling releases the open quantity and notional
+    EXPECT_TRUE(manager.process_order("AAPL", 1, 0, 0, 4, hft::OrderType::Cancel, hft::Side::Buy, 1));
+    EXPECT_EQ(manager.risk().open_quantity(1, hft::Side::Buy), 0u);
+    EXPECT_EQ(manager.risk().open_notional(1), 0u);
+    EXPECT_TRUE(manager.process_order("AAPL", 5, 100'00, 50, 5, hft::OrderType::Limit, hft::Side::Buy, 1));
+    EXPECT_FALSE(manager.process_order("AAPL", 6, 100'00, 1, 6, hft::OrderType::Limit, hft::Side::Buy, 1));
+}
+
+TEST(PreTradeRiskTest, MarketOrderCountsTowardNotional) {
+    RiskManager manager;
+    hft::RiskLimits limits;
+    limits.max_open_notional = 1'000'000'00; // 1M
+    manager.risk().set_limits(1, limits);
+
+    manager.process_order("AAPL", 1, 100'00, 50'000, 1, hft::OrderType::Limit, hft::Side::Sell, 2);
+    manager.process_order("AAPL", 2, 99'00, 50'000, 2, hft::OrderType::Limit, hft::Side::Buy, 2);
+
+    // 20k at the 100.00 offer is 2M: rejected although the order carries no price
+    EXPECT_FALSE(manager.process_order("AAPL", 3, 0, 20'000, 3, hft::OrderType::Market, hft::Side::Buy, 1));
+    EXPECT_EQ(manager.risk().position(1), 0);
+    EXPECT_TRUE(manager.process_order("AAPL", 4, 0, 5'000, 4, hft::OrderType::Market, hft::Side::Buy, 1));
+    EXPECT_EQ(manager.risk().position(1), 5'000);
+
+    // Sells are valued at the bid (99.00)
+    EXPECT_FALSE(manager.process_order("AAPL", 5, 0, 10'200, 5, hft::OrderType::Market, hft::Side::Sell, 1));
+    EXPECT_TRUE(manager.process_order("AAPL", 6, 0, 10'000, 6, hft::OrderType::Market, hft::Side::Sell, 1));
+}